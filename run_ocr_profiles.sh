@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# =============================================================================
+# run_ocr_profiles.sh - Compare the shipped OCR profiles
+# =============================================================================
+# Runs card_scanner_eval once per profile in data/ocr_profiles on the same
+# labeled directory and writes one JSON report per profile, tagged with the
+# profile name. Extra arguments are passed to every run.
+#
+# Usage: ./run_ocr_profiles.sh <labeled image dir> [evaluator options]
+# =============================================================================
+
+set -e
+
+BUILD_DIR="build"
+EVAL="$BUILD_DIR/src/tools/card_scanner_eval"
+REPORT_DIR="$BUILD_DIR/ocr_profiles"
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <labeled image dir> [evaluator options]"
+    exit 1
+fi
+SAMPLES_DIR="$1"
+shift
+
+mkdir -p "$REPORT_DIR"
+for PROFILE in data/ocr_profiles/*.json; do
+    NAME=$(basename "$PROFILE" .json)
+    echo "=== OCR profile: $NAME ==="
+    "$EVAL" -d "$SAMPLES_DIR" --ocr-profile "$PROFILE" \
+        -o "$REPORT_DIR/$NAME.json" "$@"
+done
+
+echo "Reports written to $REPORT_DIR"
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <string_view>
 
 namespace api {
 
@@ -20,6 +21,29 @@ std::string getDefaultCacheDir() {
   }
   return "./.mtg_cache";
 }
+
+// Color letters in WUBRG order. Double-faced cards have no top-level
+// colors; the front face's are used.
+std::string parseColors(const nlohmann::json &card) {
+  const nlohmann::json *colors = nullptr;
+  if (card.contains("colors")) {
+    colors = &card["colors"];
+  } else if (card.contains("card_faces") && !card["card_faces"].empty() &&
+             card["card_faces"][0].contains("colors")) {
+    colors = &card["card_faces"][0]["colors"];
+  }
+  std::string letters;
+  if (colors == nullptr || !colors->is_array()) {
+    return letters;
+  }
+  for (char color : std::string_view("WUBRG")) {
+    std::string letter(1, color);
+    if (std::find(colors->begin(), colors->end(), letter) != colors->end()) {
+      letters += color;
+    }
+  }
+  return letters;
+}
 } // namespace
 
 ScryfallClient::ScryfallClient(const std::filesystem::path &cacheDir)
@@ -100,6 +124,7 @@ CardInfo ScryfallClient::parseCardJson(const std::string &json) {
     card.collectorNumber = j.value("collector_number", "");
     card.rarity = j.value("rarity", "");
     card.typeLine = j.value("type_line", "");
+    card.colors = parseColors(j);
     card.manaCost = j.value("mana_cost", "");
     card.oracleText = j.value("oracle_text", "");
 
@@ -187,6 +212,41 @@ ScryfallClient::getCardByCollectorNumber(const std::string &setCode,
   return std::nullopt;
 }
 
+std::optional<CardInfo> ScryfallClient::getCardById(const std::string &id) {
+
+  if (id.empty()) {
+    return std::nullopt;
+  }
+
+  // Check cache first
+  std::string cache_key = "id_" + id;
+  if (auto cached = getFromCache(cache_key)) {
+    spdlog::debug("Cache hit for id: {}", id);
+    ++cacheHits_;
+    return cached;
+  }
+  ++cacheMisses_;
+
+  std::string url = std::string(BASE_URL) + "/cards/" + urlEncode(id);
+
+  spdlog::debug("Scryfall lookup: {}", url);
+
+  std::string response = httpGet(url);
+  if (response.empty()) {
+    return std::nullopt;
+  }
+
+  CardInfo card = parseCardJson(response);
+  if (card.isValid) {
+    saveToCache(cache_key, card);
+    spdlog::info("Found card by id: {} ({} #{})", card.name, card.setCode,
+                 card.collectorNumber);
+    return card;
+  }
+
+  return std::nullopt;
+}
+
 std::optional<CardInfo>
 ScryfallClient::getCardByFuzzyName(const std::string &name) {
 
@@ -280,6 +340,10 @@ std::string ScryfallClient::cardInfoToJson(const CardInfo &card) {
   j["collector_number"] = card.collectorNumber;
   j["rarity"] = card.rarity;
   j["type_line"] = card.typeLine;
+  j["colors"] = nlohmann::json::array();
+  for (char color : card.colors) {
+    j["colors"].push_back(std::string(1, color));
+  }
   j["mana_cost"] = card.manaCost;
   j["oracle_text"] = card.oracleText;
   j["image_uris"]["normal"] = card.imageUri;
@@ -293,6 +357,8 @@ std::string ScryfallClient::cardInfoToJson(const CardInfo &card) {
 }
 
 std::optional<CardInfo> ScryfallClient::getFromCache(const std::string &key) {
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+
   // Check memory cache first
   auto it = memoryCache_.find(key);
   if (it != memoryCache_.end()) {
@@ -330,6 +396,8 @@ std::optional<CardInfo> ScryfallClient::getFromCache(const std::string &key) {
 }
 
 void ScryfallClient::saveToCache(const std::string &key, const CardInfo &card) {
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+
   // Save to memory cache
   memoryCache_[key] = card;
 
@@ -348,6 +416,7 @@ void ScryfallClient::saveToCache(const std::string &key, const CardInfo &card) {
 }
 
 void ScryfallClient::clearCache() {
+  std::lock_guard<std::mutex> lock(cacheMutex_);
   memoryCache_.clear();
   cacheHits_ = 0;
   cacheMisses_ = 0;
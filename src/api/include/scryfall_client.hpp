@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -17,6 +19,7 @@ struct CardInfo {
       setName; // Full set name (e.g., "Duskmourn: House of Horror Commander")
   std::string collectorNumber; // Collector number
   std::string rarity;          // common, uncommon, rare, mythic
+  std::string colors;          // Color letters in WUBRG order (e.g., "WU")
   std::string typeLine;        // Type line (e.g., "Artifact")
   std::string manaCost;        // Mana cost (e.g., "{2}")
   std::string oracleText;      // Card rules text
@@ -28,6 +31,7 @@ struct CardInfo {
 
 /// Client for the Scryfall API (https://scryfall.com/docs/api)
 /// Includes file-based caching to avoid redundant API calls
+/// Lookups may run concurrently from several threads
 class ScryfallClient {
 public:
   /// Constructor with optional cache directory
@@ -46,6 +50,9 @@ public:
   getCardByCollectorNumber(const std::string &setCode,
                            const std::string &collectorNumber);
 
+  /// Look up a printing by its Scryfall UUID (e.g. from the art index)
+  [[nodiscard]] std::optional<CardInfo> getCardById(const std::string &id);
+
   /// Fuzzy search for a card by name
   /// Example: getCardByName("Arcane Signet")
   [[nodiscard]] std::optional<CardInfo>
@@ -76,9 +83,10 @@ private:
   [[nodiscard]] static std::string cardInfoToJson(const CardInfo &card);
 
   std::filesystem::path cacheDir_;
+  std::mutex cacheMutex_; // Guards memoryCache_ and the cache files
   std::unordered_map<std::string, CardInfo> memoryCache_;
-  mutable size_t cacheHits_{0};
-  mutable size_t cacheMisses_{0};
+  std::atomic<size_t> cacheHits_{0};
+  std::atomic<size_t> cacheMisses_{0};
 
   static constexpr const char *BASE_URL = "https://api.scryfall.com";
 };
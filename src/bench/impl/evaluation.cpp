@@ -0,0 +1,282 @@
+#include <evaluation.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace bench {
+
+namespace {
+constexpr double ms_per_second = 1000.0;
+constexpr double median_quantile = 0.5;
+constexpr double p95_quantile = 0.95;
+
+std::string trimLeadingZeros(const std::string &value) {
+  auto first_non_zero = value.find_first_not_of('0');
+  return first_non_zero == std::string::npos ? "0"
+                                             : value.substr(first_non_zero);
+}
+
+double quantile(std::vector<double> values, double q) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  auto index = static_cast<std::size_t>(
+      std::ceil(q * static_cast<double>(values.size())) - 1.0);
+  return values[std::min(index, values.size() - 1)];
+}
+
+void count(FieldAccuracy &field, bool labeled, bool correct) {
+  if (!labeled) {
+    return;
+  }
+  ++field.total;
+  if (correct) {
+    ++field.correct;
+  }
+}
+
+nlohmann::json fieldJson(const FieldAccuracy &field) {
+  return {{"correct", field.correct},
+          {"total", field.total},
+          {"rate", field.rate()}};
+}
+} // namespace
+
+bool nameMatches(const std::string &expected, const std::string &actual) {
+  return !expected.empty() &&
+         normalizeField(expected) == normalizeField(actual);
+}
+
+bool collectorNumberMatches(const std::string &expected,
+                            const std::string &actual) {
+  if (expected.empty() || actual.empty()) {
+    return false;
+  }
+  return trimLeadingZeros(normalizeField(expected)) ==
+         trimLeadingZeros(normalizeField(actual));
+}
+
+EvalSummary summarize(const std::vector<EvalRecord> &records,
+                      double wallTimeMs) {
+  EvalSummary summary;
+  summary.images = records.size();
+  summary.wallTimeMs = wallTimeMs;
+  if (wallTimeMs > 0.0) {
+    summary.cardsPerSecond =
+        static_cast<double>(records.size()) * ms_per_second / wallTimeMs;
+  }
+
+  std::map<std::string, std::vector<double>> stage_samples;
+  std::map<std::string, std::vector<double>> crop_samples;
+  for (const auto &record : records) {
+    if (!record.error.empty()) {
+      ++summary.failures;
+    }
+    if (record.rejected) {
+      ++summary.rejected;
+    }
+    if (record.sortedLocally) {
+      ++summary.sortedLocally;
+    }
+    if (record.cacheHit) {
+      ++summary.cacheHits;
+    }
+    if (record.artIdentified) {
+      ++summary.artIdentified;
+    }
+    if (record.nameSkipped) {
+      ++summary.namesSkipped;
+    }
+    if (record.digitsByTemplate) {
+      ++summary.digitTemplateReads;
+    }
+
+    const auto &label = record.expected;
+    // Cache hits and art identifications hold Scryfall's fields, which
+    // would inflate the OCR accuracy
+    bool text_read = !record.cacheHit && !record.artIdentified;
+    count(summary.name,
+          text_read && !label.name.empty() && !record.nameSkipped,
+          nameMatches(label.name, record.name));
+    count(summary.setCode, text_read && !label.setCode.empty(),
+          nameMatches(label.setCode, record.setCode));
+    count(summary.collectorNumber, text_read && !label.collectorNumber.empty(),
+          collectorNumberMatches(label.collectorNumber,
+                                 record.collectorNumber));
+
+    // Identified correctly if the printing matches, or at least the name
+    // when the label has no printing information
+    bool printing_matches =
+        nameMatches(label.setCode, record.identifiedSetCode) &&
+        collectorNumberMatches(label.collectorNumber,
+                               record.identifiedCollectorNumber);
+    bool name_matches = nameMatches(label.name, record.identifiedName);
+    bool has_printing =
+        !label.setCode.empty() && !label.collectorNumber.empty();
+    count(summary.identification, true,
+          record.identified &&
+              (has_printing ? printing_matches : name_matches));
+    // Scored against the lookup, so unlabeled images count as well
+    count(summary.rarity,
+          record.identified && !record.rarity.empty() &&
+              !record.identifiedRarity.empty(),
+          record.rarity == record.identifiedRarity);
+
+    for (const auto &[stage, ms] : record.stageMs) {
+      stage_samples[stage].push_back(ms);
+    }
+    for (const auto &[region, ratio] : record.textCrop) {
+      crop_samples[region].push_back(ratio);
+    }
+  }
+
+  for (auto &[stage, samples] : stage_samples) {
+    StageStats stats;
+    double sum = 0.0;
+    for (double ms : samples) {
+      sum += ms;
+    }
+    stats.meanMs = sum / static_cast<double>(samples.size());
+    stats.p50Ms = quantile(samples, median_quantile);
+    stats.p95Ms = quantile(samples, p95_quantile);
+    summary.stages[stage] = stats;
+  }
+  for (const auto &[region, samples] : crop_samples) {
+    double sum = 0.0;
+    for (double ratio : samples) {
+      sum += ratio;
+    }
+    summary.textCrop[region] = sum / static_cast<double>(samples.size());
+  }
+  return summary;
+}
+
+std::string toJson(const EvalSummary &summary,
+                   const std::vector<EvalRecord> &records,
+                   const std::string &tag) {
+  nlohmann::json report;
+  report["tag"] = tag;
+
+  auto &json_summary = report["summary"];
+  json_summary["images"] = summary.images;
+  json_summary["failures"] = summary.failures;
+  json_summary["rejected"] = summary.rejected;
+  json_summary["sorted_locally"] = summary.sortedLocally;
+  json_summary["names_skipped"] = summary.namesSkipped;
+  json_summary["digits_by_template"] = summary.digitTemplateReads;
+  json_summary["cache"] = {{"hits", summary.cacheHits},
+                           {"saved_ms", summary.cacheSavedMs}};
+  json_summary["art_identified"] = summary.artIdentified;
+  json_summary["memory"] = {{"resident_mb", summary.residentMb},
+                            {"file_backed_mb", summary.fileBackedMb},
+                            {"peak_resident_mb", summary.peakResidentMb}};
+  json_summary["wall_time_ms"] = summary.wallTimeMs;
+  json_summary["cards_per_second"] = summary.cardsPerSecond;
+  json_summary["accuracy"]["name"] = fieldJson(summary.name);
+  json_summary["accuracy"]["set_code"] = fieldJson(summary.setCode);
+  json_summary["accuracy"]["collector_number"] =
+      fieldJson(summary.collectorNumber);
+  json_summary["accuracy"]["identification"] =
+      fieldJson(summary.identification);
+  json_summary["accuracy"]["rarity"] = fieldJson(summary.rarity);
+  for (const auto &[region, ratio] : summary.textCrop) {
+    json_summary["text_crop"][region] = ratio;
+  }
+  for (const auto &[stage, stats] : summary.stages) {
+    json_summary["stages"][stage] = {{"mean_ms", stats.meanMs},
+                                     {"p50_ms", stats.p50Ms},
+                                     {"p95_ms", stats.p95Ms}};
+  }
+
+  auto &json_records = report["records"];
+  json_records = nlohmann::json::array();
+  for (const auto &record : records) {
+    nlohmann::json entry;
+    entry["file"] = record.file;
+    entry["expected"] = {{"name", record.expected.name},
+                         {"set", record.expected.setCode},
+                         {"collector_number", record.expected.collectorNumber}};
+    entry["ocr"] = {{"name", record.name},
+                    {"set", record.setCode},
+                    {"collector_number", record.collectorNumber}};
+    entry["quality"] = {{"focus", record.focus},
+                        {"clipped_ratio", record.clippedRatio},
+                        {"rejected", record.rejected}};
+    entry["cache_hit"] = record.cacheHit;
+    entry["art_identified"] = record.artIdentified;
+    entry["name_skipped"] = record.nameSkipped;
+    entry["digits_by_template"] = record.digitsByTemplate;
+    entry["identified"] = record.identified;
+    if (record.identified) {
+      entry["card"] = {{"name", record.identifiedName},
+                       {"set", record.identifiedSetCode},
+                       {"collector_number", record.identifiedCollectorNumber},
+                       {"rarity", record.identifiedRarity}};
+    }
+    if (!record.rarity.empty()) {
+      entry["rarity"] = record.rarity;
+    }
+    if (record.bin >= 0) {
+      entry["bin"] = {{"bin", record.bin},
+                      {"rule", record.binRule},
+                      {"sorted_locally", record.sortedLocally}};
+    }
+    entry["stages_ms"] = record.stageMs;
+    if (!record.textCrop.empty()) {
+      entry["text_crop"] = record.textCrop;
+    }
+    if (!record.error.empty()) {
+      entry["error"] = record.error;
+    }
+    json_records.push_back(entry);
+  }
+  return report.dump(2);
+}
+
+void logSummary(const EvalSummary &summary) {
+  spdlog::info("=== Evaluation Summary ===");
+  spdlog::info("Images: {} ({} failed, {} rejected before OCR, {} sorted "
+               "without OCR)",
+               summary.images, summary.failures, summary.rejected,
+               summary.sortedLocally);
+  spdlog::info("Name accuracy: {:.1f}% ({}/{}, {} not read)",
+               summary.name.rate() * 100.0, summary.name.correct,
+               summary.name.total, summary.namesSkipped);
+  spdlog::info("Set code accuracy: {:.1f}% ({}/{})",
+               summary.setCode.rate() * 100.0, summary.setCode.correct,
+               summary.setCode.total);
+  spdlog::info("Collector number accuracy: {:.1f}% ({}/{}, {} by template)",
+               summary.collectorNumber.rate() * 100.0,
+               summary.collectorNumber.correct, summary.collectorNumber.total,
+               summary.digitTemplateReads);
+  spdlog::info("Not read by OCR and left out of the field accuracy: {} "
+               "cache hits, {} art identifications",
+               summary.cacheHits, summary.artIdentified);
+  spdlog::info("Identification rate: {:.1f}% ({}/{})",
+               summary.identification.rate() * 100.0,
+               summary.identification.correct, summary.identification.total);
+  spdlog::info("Symbol rarity agreement: {:.1f}% ({}/{})",
+               summary.rarity.rate() * 100.0, summary.rarity.correct,
+               summary.rarity.total);
+  spdlog::info("Throughput: {:.2f} cards/s ({:.0f} ms total)",
+               summary.cardsPerSecond, summary.wallTimeMs);
+  spdlog::info("Recognition cache: {} hits, {:.0f} ms saved",
+               summary.cacheHits, summary.cacheSavedMs);
+  spdlog::info("Memory: {:.0f} MB resident ({:.0f} MB file-backed), "
+               "peak {:.0f} MB",
+               summary.residentMb, summary.fileBackedMb,
+               summary.peakResidentMb);
+  for (const auto &[region, ratio] : summary.textCrop) {
+    spdlog::info("Text crop: {} keeps {:.0f}% of its region pixels", region,
+                 ratio * 100.0);
+  }
+  for (const auto &[stage, stats] : summary.stages) {
+    spdlog::info("  {:<10} mean {:8.2f} ms  p50 {:8.2f} ms  p95 {:8.2f} ms",
+                 stage, stats.meanMs, stats.p50Ms, stats.p95Ms);
+  }
+}
+
+} // namespace bench
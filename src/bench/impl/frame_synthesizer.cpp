@@ -0,0 +1,192 @@
+#include <frame_synthesizer.hpp>
+#include <libassert/assert.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace bench {
+
+namespace {
+constexpr double degrees_to_radians = CV_PI / 180.0;
+constexpr double scale_shrink_step = 0.9; // Shrink factor when card won't fit
+constexpr int max_fit_attempts = 20;
+constexpr double min_blur_sigma = 0.3;   // Below this blur is skipped
+constexpr int background_cells = 8;      // Procedural background grid size
+constexpr int background_min_value = 60; // Procedural base color range
+constexpr int background_max_value = 190;
+constexpr int background_contrast = 40; // Cell variation around base color
+} // namespace
+
+FrameSynthesizer::FrameSynthesizer(SynthesisParams params, std::uint64_t seed)
+    : params_(params), rng_(seed) {
+  ASSERT(params_.frameSize.width > 0 && params_.frameSize.height > 0,
+         "Frame size must be positive");
+  ASSERT(params_.minCardHeight > 0.0 &&
+             params_.minCardHeight <= params_.maxCardHeight,
+         "Invalid card height range");
+}
+
+SyntheticFrame FrameSynthesizer::generate(const cv::Mat &card,
+                                          const cv::Mat &background) {
+  ASSERT(!card.empty(), "Card image is empty");
+  ASSERT(card.channels() == 3, "Card image must be BGR");
+
+  SyntheticFrame frame;
+  frame.image = makeBackground(background);
+  frame.corners = randomCardQuad(card.size());
+
+  // Map the card onto its random quad in the frame
+  std::vector<cv::Point2f> card_corners{
+      cv::Point2f(0.0F, 0.0F), cv::Point2f(static_cast<float>(card.cols), 0.0F),
+      cv::Point2f(static_cast<float>(card.cols),
+                  static_cast<float>(card.rows)),
+      cv::Point2f(0.0F, static_cast<float>(card.rows))};
+  cv::Mat transform = cv::getPerspectiveTransform(card_corners, frame.corners);
+
+  cv::Mat warped;
+  cv::warpPerspective(card, warped, transform, params_.frameSize,
+                      cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+  cv::Mat mask;
+  cv::warpPerspective(cv::Mat(card.size(), CV_8UC1, cv::Scalar(255)), mask,
+                      transform, params_.frameSize, cv::INTER_NEAREST,
+                      cv::BORDER_CONSTANT);
+  warped.copyTo(frame.image, mask);
+
+  applyLighting(frame.image);
+  applyBlurAndNoise(frame.image);
+  return frame;
+}
+
+cv::Mat FrameSynthesizer::makeBackground(const cv::Mat &background) {
+  cv::Mat result;
+  if (!background.empty()) {
+    cv::resize(background, result, params_.frameSize, 0, 0, cv::INTER_AREA);
+    if (result.channels() == 1) {
+      cv::cvtColor(result, result, cv::COLOR_GRAY2BGR);
+    }
+    return result;
+  }
+
+  // Procedural background: a random base color with smooth blotches
+  cv::Scalar base(rng_.uniform(background_min_value, background_max_value),
+                  rng_.uniform(background_min_value, background_max_value),
+                  rng_.uniform(background_min_value, background_max_value));
+  cv::Mat cells(background_cells, background_cells, CV_8UC3);
+  rng_.fill(cells, cv::RNG::UNIFORM,
+            base - cv::Scalar::all(background_contrast),
+            base + cv::Scalar::all(background_contrast));
+  cv::resize(cells, result, params_.frameSize, 0, 0, cv::INTER_CUBIC);
+  return result;
+}
+
+std::vector<cv::Point2f>
+FrameSynthesizer::randomCardQuad(const cv::Size &card) {
+  const auto frame_w = static_cast<double>(params_.frameSize.width);
+  const auto frame_h = static_cast<double>(params_.frameSize.height);
+
+  double card_height = rng_.uniform(params_.minCardHeight,
+                                    params_.maxCardHeight) *
+                       frame_h;
+  double angle = rng_.uniform(-params_.maxRotationDeg, params_.maxRotationDeg) *
+                 degrees_to_radians;
+  double cos_a = std::cos(angle);
+  double sin_a = std::sin(angle);
+
+  // Shrink the card until the rotated, jittered quad fits inside the frame.
+  // The extents bound every corner, so the labels never need clamping and
+  // always match the rendered card.
+  double half_w = 0.0;
+  double half_h = 0.0;
+  double jitter = 0.0;
+  double extent_x = 0.0;
+  double extent_y = 0.0;
+  bool fits = false;
+  for (int attempt = 0; attempt < max_fit_attempts && !fits; ++attempt) {
+    half_h = card_height / 2.0;
+    half_w = half_h * card.width / card.height;
+    jitter = params_.maxPerspective * 2.0 * std::max(half_w, half_h);
+    extent_x = std::abs(half_w * cos_a) + std::abs(half_h * sin_a) + jitter;
+    extent_y = std::abs(half_w * sin_a) + std::abs(half_h * cos_a) + jitter;
+    fits = 2.0 * extent_x < frame_w && 2.0 * extent_y < frame_h;
+    if (!fits) {
+      card_height *= scale_shrink_step;
+    }
+  }
+  if (!fits) {
+    throw std::runtime_error("Card does not fit the frame; reduce the "
+                             "perspective jitter or the card height");
+  }
+
+  double center_x = rng_.uniform(extent_x, frame_w - extent_x);
+  double center_y = rng_.uniform(extent_y, frame_h - extent_y);
+
+  // Card-local corners in TL, TR, BR, BL order
+  const std::array<cv::Point2d, 4> local{
+      cv::Point2d(-half_w, -half_h), cv::Point2d(half_w, -half_h),
+      cv::Point2d(half_w, half_h), cv::Point2d(-half_w, half_h)};
+
+  std::vector<cv::Point2f> corners;
+  corners.reserve(local.size());
+  for (const auto &point : local) {
+    double x = center_x + point.x * cos_a - point.y * sin_a +
+               rng_.uniform(-jitter, jitter);
+    double y = center_y + point.x * sin_a + point.y * cos_a +
+               rng_.uniform(-jitter, jitter);
+    corners.emplace_back(static_cast<float>(x), static_cast<float>(y));
+  }
+  return corners;
+}
+
+void FrameSynthesizer::applyLighting(cv::Mat &frame) {
+  double gain = rng_.uniform(params_.minGain, params_.maxGain);
+  double bias = rng_.uniform(-params_.maxBias, params_.maxBias);
+  double gradient = rng_.uniform(0.0, params_.maxGradient);
+  double direction = rng_.uniform(0.0, 2.0 * CV_PI);
+  auto dir_x = static_cast<float>(std::cos(direction) * gradient);
+  auto dir_y = static_cast<float>(std::sin(direction) * gradient);
+
+  // Per-pixel gain: global gain modulated by a linear gradient across the frame
+  cv::Mat gain_map(frame.size(), CV_32FC1);
+  const float inv_w = 1.0F / static_cast<float>(frame.cols);
+  const float inv_h = 1.0F / static_cast<float>(frame.rows);
+  for (int y = 0; y < gain_map.rows; ++y) {
+    auto *row = gain_map.ptr<float>(y);
+    float dy = (static_cast<float>(y) * inv_h - 0.5F) * dir_y;
+    for (int x = 0; x < gain_map.cols; ++x) {
+      float dx = (static_cast<float>(x) * inv_w - 0.5F) * dir_x;
+      row[x] = static_cast<float>(gain) * (1.0F + dx + dy);
+    }
+  }
+
+  cv::Mat gain_bgr;
+  cv::merge(std::vector<cv::Mat>{gain_map, gain_map, gain_map}, gain_bgr);
+
+  cv::Mat frame_f;
+  frame.convertTo(frame_f, CV_32FC3);
+  cv::multiply(frame_f, gain_bgr, frame_f);
+  frame_f += cv::Scalar::all(bias);
+  frame_f.convertTo(frame, CV_8UC3);
+}
+
+void FrameSynthesizer::applyBlurAndNoise(cv::Mat &frame) {
+  double sigma = rng_.uniform(0.0, params_.maxBlurSigma);
+  if (sigma > min_blur_sigma) {
+    cv::GaussianBlur(frame, frame, cv::Size(0, 0), sigma);
+  }
+
+  double noise_stddev = rng_.uniform(0.0, params_.maxNoiseStddev);
+  if (noise_stddev > 0.0) {
+    cv::Mat noise(frame.size(), CV_16SC3);
+    rng_.fill(noise, cv::RNG::NORMAL, cv::Scalar::all(0),
+              cv::Scalar::all(noise_stddev));
+    cv::Mat frame_s;
+    frame.convertTo(frame_s, CV_16SC3);
+    frame_s += noise;
+    frame_s.convertTo(frame, CV_8UC3);
+  }
+}
+
+} // namespace bench
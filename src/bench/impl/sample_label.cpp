@@ -0,0 +1,228 @@
+#include <sample_label.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+namespace bench {
+
+namespace {
+constexpr const char *sidecar_name = "labels.csv";
+constexpr std::size_t corner_columns = 8; // x0,y0 .. x3,y3
+constexpr std::size_t min_columns = 4;    // file,set,collector_number,name
+constexpr std::size_t max_set_code_length = 6;
+
+std::vector<std::string> splitCsvLine(const std::string &line) {
+  std::vector<std::string> fields;
+  std::string field;
+  bool in_quotes = false;
+
+  for (std::size_t i = 0; i < line.size(); ++i) {
+    char c = line[i];
+    if (in_quotes) {
+      if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+        field += '"';
+        ++i;
+      } else if (c == '"') {
+        in_quotes = false;
+      } else {
+        field += c;
+      }
+    } else if (c == '"') {
+      in_quotes = true;
+    } else if (c == ',') {
+      fields.push_back(field);
+      field.clear();
+    } else if (c != '\r') {
+      field += c;
+    }
+  }
+  fields.push_back(field);
+  return fields;
+}
+
+std::string quoteCsvField(const std::string &value) {
+  if (value.find_first_of(",\"") == std::string::npos) {
+    return value;
+  }
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+std::string stripLeadingZeros(const std::string &number) {
+  auto first_non_zero = number.find_first_not_of('0');
+  if (first_non_zero == std::string::npos) {
+    return number.empty() ? number : "0";
+  }
+  return number.substr(first_non_zero);
+}
+
+bool isAlnum(const std::string &token) {
+  return !token.empty() &&
+         std::all_of(token.begin(), token.end(), [](unsigned char c) {
+           return std::isalnum(c) != 0;
+         });
+}
+
+bool isImageFile(const std::filesystem::path &path) {
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp";
+}
+} // namespace
+
+std::optional<SampleLabel>
+parseLabelFromFilename(const std::filesystem::path &imagePath) {
+  std::string stem = imagePath.stem().string();
+
+  std::vector<std::string> tokens;
+  std::stringstream stream(stem);
+  std::string token;
+  while (std::getline(stream, token, '-')) {
+    tokens.push_back(token);
+  }
+
+  // Need at least set, collector number and one name word
+  if (tokens.size() < 3) {
+    return std::nullopt;
+  }
+
+  const std::string &set_code = tokens[0];
+  const std::string &number = tokens[1];
+  if (!isAlnum(set_code) || set_code.size() > max_set_code_length) {
+    return std::nullopt;
+  }
+  if (!isAlnum(number) ||
+      std::isdigit(static_cast<unsigned char>(number[0])) == 0) {
+    return std::nullopt;
+  }
+
+  SampleLabel label;
+  label.setCode = set_code;
+  label.collectorNumber = stripLeadingZeros(number);
+  for (std::size_t i = 2; i < tokens.size(); ++i) {
+    if (!label.name.empty()) {
+      label.name += ' ';
+    }
+    label.name += tokens[i];
+  }
+  return label;
+}
+
+LabelMap readLabelCsv(const std::filesystem::path &csvPath) {
+  LabelMap labels;
+  std::ifstream file(csvPath);
+  if (!file.is_open()) {
+    spdlog::error("Failed to open label file: {}", csvPath.string());
+    return labels;
+  }
+
+  std::string line;
+  bool header = true;
+  while (std::getline(file, line)) {
+    if (header) {
+      header = false;
+      continue;
+    }
+    if (line.empty()) {
+      continue;
+    }
+
+    auto fields = splitCsvLine(line);
+    if (fields.size() < min_columns) {
+      spdlog::warn("Skipping malformed label line: {}", line);
+      continue;
+    }
+
+    SampleLabel label;
+    label.setCode = fields[1];
+    label.collectorNumber = stripLeadingZeros(fields[2]);
+    label.name = fields[3];
+
+    if (fields.size() >= min_columns + corner_columns &&
+        !fields[min_columns].empty()) {
+      try {
+        for (std::size_t i = 0; i < corner_columns; i += 2) {
+          label.corners.emplace_back(std::stof(fields[min_columns + i]),
+                                     std::stof(fields[min_columns + i + 1]));
+        }
+      } catch (const std::exception &e) {
+        spdlog::warn("Invalid corner values for {}: {}", fields[0], e.what());
+        label.corners.clear();
+      }
+    }
+
+    labels[fields[0]] = label;
+  }
+  return labels;
+}
+
+bool writeLabelCsv(const std::filesystem::path &csvPath,
+                   const LabelMap &labels) {
+  std::ofstream file(csvPath);
+  if (!file.is_open()) {
+    spdlog::error("Failed to write label file: {}", csvPath.string());
+    return false;
+  }
+
+  file << "file,set,collector_number,name,x0,y0,x1,y1,x2,y2,x3,y3\n";
+  for (const auto &[file_name, label] : labels) {
+    file << quoteCsvField(file_name) << ',' << quoteCsvField(label.setCode)
+         << ',' << quoteCsvField(label.collectorNumber) << ','
+         << quoteCsvField(label.name);
+    if (label.corners.size() == 4) {
+      for (const auto &corner : label.corners) {
+        file << ',' << corner.x << ',' << corner.y;
+      }
+    } else {
+      file << ",,,,,,,,";
+    }
+    file << '\n';
+  }
+  return file.good();
+}
+
+LabelMap collectLabels(const std::filesystem::path &directory) {
+  LabelMap labels;
+  auto sidecar = directory / sidecar_name;
+  LabelMap csv_labels;
+  if (std::filesystem::exists(sidecar)) {
+    csv_labels = readLabelCsv(sidecar);
+  }
+
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    if (!entry.is_regular_file() || !isImageFile(entry.path())) {
+      continue;
+    }
+    std::string file_name = entry.path().filename().string();
+
+    auto csv_it = csv_labels.find(file_name);
+    if (csv_it != csv_labels.end()) {
+      labels[file_name] = csv_it->second;
+    } else if (auto parsed = parseLabelFromFilename(entry.path())) {
+      labels[file_name] = *parsed;
+    }
+  }
+  return labels;
+}
+
+std::string normalizeField(const std::string &value) {
+  std::string normalized;
+  for (unsigned char c : value) {
+    if (std::isalnum(c) != 0) {
+      normalized += static_cast<char>(std::tolower(c));
+    }
+  }
+  return normalized;
+}
+
+} // namespace bench
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <sample_label.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Pipeline output for one labeled image
+struct EvalRecord {
+  std::string file;
+  SampleLabel expected;
+
+  // Raw OCR fields; the name is only read when the lookup key is unsure.
+  // Scryfall's fields for cache hits and art identifications.
+  std::string name;
+  std::string setCode;
+  std::string collectorNumber;
+
+  // Card returned by the lookup (empty if not identified)
+  bool identified{false};
+  std::string identifiedName;
+  std::string identifiedSetCode;
+  std::string identifiedCollectorNumber;
+  std::string identifiedRarity;
+
+  // Rarity read from the set symbol color (empty if not classified)
+  std::string rarity;
+
+  // Bin the rules chose and the rule that fired (-1 without bin rules);
+  // sorted locally if the frame color and rarity decided it without OCR
+  int bin{-1};
+  std::string binRule;
+  bool sortedLocally{false};
+
+  // Quality gate scores; rejected cards (blurry, glared, face down or not a
+  // card) skipped OCR and lookup
+  double focus{0.0};
+  double clippedRatio{0.0};
+  bool rejected{false};
+
+  bool cacheHit{false};         // Recalled from the recognition cache, no OCR
+  bool artIdentified{false};    // Identified by the art index, no OCR
+  bool nameSkipped{false};      // Name OCR was not needed; not scored
+  bool digitsByTemplate{false}; // Collector number read without Tesseract
+
+  std::map<std::string, double> stageMs;  // Stage name -> milliseconds
+  std::map<std::string, double> textCrop; // Region -> share of pixels read
+  std::string error;                      // Non-empty if processing threw
+};
+
+/// Correct/total counter for one field
+struct FieldAccuracy {
+  std::size_t correct{0};
+  std::size_t total{0};
+
+  [[nodiscard]] double rate() const {
+    return total == 0 ? 0.0 : static_cast<double>(correct) / total;
+  }
+};
+
+/// Timing statistics for one stage
+struct StageStats {
+  double meanMs{0.0};
+  double p50Ms{0.0};
+  double p95Ms{0.0};
+};
+
+/// Aggregated accuracy and throughput over an evaluation run
+struct EvalSummary {
+  std::size_t images{0};
+  std::size_t failures{0};           // Images where processing threw
+  std::size_t rejected{0};           // Images rejected before OCR
+  std::size_t sortedLocally{0};      // Binned without OCR or lookup
+  std::size_t namesSkipped{0};       // Identified without reading the name
+  std::size_t cacheHits{0};          // Recalled from the recognition cache
+  std::size_t artIdentified{0};      // Identified by the art index
+  std::size_t digitTemplateReads{0}; // Collector numbers read by templates
+  double cacheSavedMs{0.0};          // OCR and lookup time the hits saved
+  double residentMb{0.0};            // Process memory after the run
+  double fileBackedMb{0.0};          // Part of it backed by mapped files
+  double peakResidentMb{0.0};
+  // OCR reads only; cache hits and art identifications are not scored
+  FieldAccuracy name;
+  FieldAccuracy setCode;
+  FieldAccuracy collectorNumber;
+  FieldAccuracy identification; // Lookup returned the labeled card
+  FieldAccuracy rarity; // Symbol rarity agrees with the identified card
+  double wallTimeMs{0.0};
+  double cardsPerSecond{0.0};
+  std::map<std::string, StageStats> stages;
+  std::map<std::string, double> textCrop; // Region -> mean share read
+};
+
+/// Field comparisons used by the summary (case and punctuation insensitive)
+[[nodiscard]] bool nameMatches(const std::string &expected,
+                               const std::string &actual);
+[[nodiscard]] bool collectorNumberMatches(const std::string &expected,
+                                          const std::string &actual);
+
+/// Score all records against their labels
+[[nodiscard]] EvalSummary summarize(const std::vector<EvalRecord> &records,
+                                    double wallTimeMs);
+
+/// Machine-readable report with the summary and every record
+[[nodiscard]] std::string toJson(const EvalSummary &summary,
+                                 const std::vector<EvalRecord> &records,
+                                 const std::string &tag = "");
+
+/// Log a human-readable summary
+void logSummary(const EvalSummary &summary);
+
+} // namespace bench
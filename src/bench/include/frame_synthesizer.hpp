@@ -0,0 +1,56 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+/// Randomization ranges for synthetic frames
+struct SynthesisParams {
+  cv::Size frameSize{1280, 960};
+  double minCardHeight{0.45};     // Card height as fraction of frame height
+  double maxCardHeight{0.85};     // Card height as fraction of frame height
+  double maxRotationDeg{20.0};    // In-plane rotation range (+/-)
+  double maxPerspective{0.06};    // Corner jitter as fraction of card size
+  double maxBlurSigma{1.5};       // Gaussian blur sigma upper bound
+  double maxNoiseStddev{8.0};     // Additive Gaussian noise upper bound
+  double minGain{0.7};            // Global brightness gain range
+  double maxGain{1.3};
+  double maxBias{25.0};           // Global brightness offset range (+/-)
+  double maxGradient{0.3};        // Strength of the linear lighting gradient
+};
+
+/// One generated frame and the card corners inside it
+struct SyntheticFrame {
+  cv::Mat image;
+  std::vector<cv::Point2f> corners; // TL, TR, BR, BL of the card itself
+};
+
+/// Composites card images onto backgrounds with random pose and lighting.
+/// The sequence of frames is fully determined by the seed.
+class FrameSynthesizer {
+public:
+  explicit FrameSynthesizer(SynthesisParams params = {},
+                            std::uint64_t seed = 0);
+
+  /// Generate one frame. An empty background yields a procedural one.
+  /// Throws std::runtime_error if even a shrunk card cannot fit the frame
+  /// with the configured perspective jitter.
+  [[nodiscard]] SyntheticFrame generate(const cv::Mat &card,
+                                        const cv::Mat &background = {});
+
+  [[nodiscard]] const SynthesisParams &params() const { return params_; }
+
+private:
+  [[nodiscard]] cv::Mat makeBackground(const cv::Mat &background);
+  [[nodiscard]] std::vector<cv::Point2f> randomCardQuad(const cv::Size &card);
+  void applyLighting(cv::Mat &frame);
+  void applyBlurAndNoise(cv::Mat &frame);
+
+  SynthesisParams params_;
+  cv::RNG rng_;
+};
+
+} // namespace bench
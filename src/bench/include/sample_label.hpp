@@ -0,0 +1,43 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Ground truth for one labeled image (sample photo or synthetic frame)
+struct SampleLabel {
+  std::string setCode;         // Set code as printed (e.g., "cn2")
+  std::string collectorNumber; // Collector number without leading zeros
+  std::string name;            // Card name
+  std::vector<cv::Point2f> corners; // Card corners TL, TR, BR, BL (optional)
+};
+
+/// Labels keyed by image file name (not full path)
+using LabelMap = std::map<std::string, SampleLabel>;
+
+/// Parse a label from a file name of the form "<set>-<number>-<name>.<ext>"
+/// Example: "cn2-78-queen-marchesa.jpg" -> {"cn2", "78", "queen marchesa"}
+[[nodiscard]] std::optional<SampleLabel>
+parseLabelFromFilename(const std::filesystem::path &imagePath);
+
+/// Read a sidecar label CSV (header: file,set,collector_number,name[,x0..y3])
+[[nodiscard]] LabelMap readLabelCsv(const std::filesystem::path &csvPath);
+
+/// Write labels as CSV, including corner columns
+[[nodiscard]] bool writeLabelCsv(const std::filesystem::path &csvPath,
+                                 const LabelMap &labels);
+
+/// Collect labels for every image in a directory. Entries from a
+/// "labels.csv" sidecar take precedence over labels parsed from file names.
+[[nodiscard]] LabelMap collectLabels(const std::filesystem::path &directory);
+
+/// Normalize a text field for comparison (lowercase, alphanumerics only)
+[[nodiscard]] std::string normalizeField(const std::string &value);
+
+} // namespace bench
@@ -0,0 +1,120 @@
+#include <camera_stream.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace capture {
+
+namespace {
+constexpr double ms_per_second = 1000.0;
+} // namespace
+
+CameraStream::CameraStream(std::string source, std::size_t bufferSize,
+                           double sourceFps)
+    : source_(std::move(source)), sourceFps_(sourceFps), buffer_(bufferSize) {}
+
+CameraStream::~CameraStream() { stop(); }
+
+bool CameraStream::isDeviceIndex() const {
+  return !source_.empty() &&
+         std::all_of(source_.begin(), source_.end(), [](unsigned char c) {
+           return std::isdigit(c) != 0;
+         });
+}
+
+bool CameraStream::start() {
+  if (running_) {
+    return true;
+  }
+
+  bool opened = isDeviceIndex()
+                    ? capture_.open(std::stoi(source_), cv::CAP_V4L2)
+                    : capture_.open(source_, cv::CAP_ANY);
+  if (!opened || !capture_.isOpened()) {
+    spdlog::error("Failed to open capture source: {}", source_);
+    return false;
+  }
+
+  spdlog::info("Opened capture source {} ({}x{} @ {:.1f} fps)", source_,
+               capture_.get(cv::CAP_PROP_FRAME_WIDTH),
+               capture_.get(cv::CAP_PROP_FRAME_HEIGHT),
+               capture_.get(cv::CAP_PROP_FPS));
+
+  stopRequested_ = false;
+  running_ = true;
+  startTime_ = std::chrono::steady_clock::now();
+  thread_ = std::thread(&CameraStream::captureLoop, this);
+  return true;
+}
+
+void CameraStream::stop() {
+  stopRequested_ = true;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  buffer_.close();
+  if (capture_.isOpened()) {
+    capture_.release();
+  }
+}
+
+void CameraStream::captureLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto frame_interval =
+      sourceFps_ > 0.0 ? std::chrono::duration_cast<Clock::duration>(
+                             std::chrono::duration<double>(1.0 / sourceFps_))
+                       : Clock::duration::zero();
+  auto next_frame_time = Clock::now();
+
+  cv::Mat frame;
+  while (!stopRequested_) {
+    if (!capture_.read(frame) || frame.empty()) {
+      spdlog::info("Capture source ended after {} frames",
+                   buffer_.pushedCount());
+      break;
+    }
+    buffer_.push(frame);
+
+    // Emulate a live camera when replaying a file
+    if (frame_interval > Clock::duration::zero()) {
+      next_frame_time += frame_interval;
+      std::this_thread::sleep_until(next_frame_time);
+    }
+  }
+
+  running_ = false;
+  buffer_.close();
+}
+
+bool CameraStream::nextFrame(CapturedFrame &frame,
+                             std::chrono::milliseconds timeout) {
+  return buffer_.popLatest(frame, timeout);
+}
+
+bool CameraStream::isExhausted() const {
+  return !running_ && buffer_.isClosed() &&
+         buffer_.pushedCount() ==
+             buffer_.consumedCount() + buffer_.droppedCount();
+}
+
+StreamStats CameraStream::stats() const {
+  StreamStats stats;
+  stats.captured = buffer_.pushedCount();
+  stats.processed = buffer_.consumedCount();
+  stats.dropped = buffer_.droppedCount();
+
+  double elapsed_ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - startTime_)
+                          .count();
+  if (elapsed_ms > 0.0) {
+    stats.captureFps =
+        static_cast<double>(stats.captured) * ms_per_second / elapsed_ms;
+    stats.processFps =
+        static_cast<double>(stats.processed) * ms_per_second / elapsed_ms;
+  }
+  return stats;
+}
+
+} // namespace capture
@@ -0,0 +1,76 @@
+#include <frame_ring_buffer.hpp>
+#include <libassert/assert.hpp>
+
+#include <utility>
+
+namespace capture {
+
+FrameRingBuffer::FrameRingBuffer(std::size_t capacity) : slots_(capacity) {
+  ASSERT(capacity > 0, "Ring buffer capacity must be positive");
+}
+
+void FrameRingBuffer::push(const cv::Mat &frame) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &slot = slots_[pushed_ % slots_.size()];
+    frame.copyTo(slot.image);
+    slot.sequence = ++pushed_;
+    slot.timestamp = std::chrono::steady_clock::now();
+  }
+  frameAvailable_.notify_one();
+}
+
+bool FrameRingBuffer::popLatest(CapturedFrame &frame,
+                                std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  bool ready = frameAvailable_.wait_for(lock, timeout, [this] {
+    return closed_ || pushed_ > lastConsumedSequence_;
+  });
+  if (!ready || pushed_ == lastConsumedSequence_) {
+    return false;
+  }
+
+  // Newest frame is the one written last; everything between the last
+  // consumed frame and it is skipped
+  auto &slot = slots_[(pushed_ - 1) % slots_.size()];
+  dropped_ += slot.sequence - lastConsumedSequence_ - 1;
+  lastConsumedSequence_ = slot.sequence;
+  ++consumed_;
+
+  // Hand the buffer over instead of copying it; the slot allocates a fresh
+  // one on its next write, so the caller may keep the image
+  frame.image = std::move(slot.image);
+  frame.sequence = slot.sequence;
+  frame.timestamp = slot.timestamp;
+  return true;
+}
+
+void FrameRingBuffer::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  frameAvailable_.notify_all();
+}
+
+bool FrameRingBuffer::isClosed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return closed_;
+}
+
+std::uint64_t FrameRingBuffer::pushedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pushed_;
+}
+
+std::uint64_t FrameRingBuffer::consumedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return consumed_;
+}
+
+std::uint64_t FrameRingBuffer::droppedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+} // namespace capture
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <frame_ring_buffer.hpp>
+#include <opencv2/opencv.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace capture {
+
+/// Capture and processing rates of a running stream
+struct StreamStats {
+  std::uint64_t captured{0};
+  std::uint64_t processed{0};
+  std::uint64_t dropped{0};
+  double captureFps{0.0};
+  double processFps{0.0};
+};
+
+/// Reads frames from a camera (V4L2 device index) or a stand-in source
+/// (video file or image sequence pattern such as "frames/%04d.jpg") on a
+/// background thread into a ring buffer. The consumer always gets the newest
+/// frame; stale frames are dropped when processing falls behind.
+class CameraStream {
+public:
+  /// @param source Device index ("0") or a file path / image sequence pattern
+  /// @param bufferSize Number of frames kept in the ring buffer
+  /// @param sourceFps Pace file sources at this rate (0 = as fast as possible)
+  explicit CameraStream(std::string source, std::size_t bufferSize = 4,
+                        double sourceFps = 0.0);
+  ~CameraStream();
+
+  // Non-copyable
+  CameraStream(const CameraStream &) = delete;
+  CameraStream &operator=(const CameraStream &) = delete;
+
+  /// Open the source and start the capture thread
+  [[nodiscard]] bool start();
+
+  /// Stop the capture thread and release the source
+  void stop();
+
+  /// Get the newest frame. Returns false once the source is exhausted (or
+  /// stopped) and no frame is pending, or when the timeout expires.
+  [[nodiscard]] bool nextFrame(CapturedFrame &frame,
+                               std::chrono::milliseconds timeout =
+                                   std::chrono::milliseconds(1000));
+
+  /// True while the capture thread is running
+  [[nodiscard]] bool isRunning() const { return running_; }
+
+  /// True if the source ended and all frames were consumed or dropped
+  [[nodiscard]] bool isExhausted() const;
+
+  [[nodiscard]] StreamStats stats() const;
+
+private:
+  void captureLoop();
+  [[nodiscard]] bool isDeviceIndex() const;
+
+  std::string source_;
+  double sourceFps_;
+  cv::VideoCapture capture_;
+  FrameRingBuffer buffer_;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::chrono::steady_clock::time_point startTime_;
+};
+
+} // namespace capture
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace capture {
+
+/// A frame taken from the camera with its capture order and time
+struct CapturedFrame {
+  cv::Mat image;
+  std::uint64_t sequence{0}; // 1-based capture index
+  std::chrono::steady_clock::time_point timestamp;
+};
+
+/// Fixed-size ring of frames shared between one capture thread and one
+/// processing thread. The producer never blocks: it overwrites the oldest
+/// slot. The consumer always takes the newest frame; every frame it skips
+/// is counted as dropped.
+class FrameRingBuffer {
+public:
+  explicit FrameRingBuffer(std::size_t capacity);
+
+  // Non-copyable
+  FrameRingBuffer(const FrameRingBuffer &) = delete;
+  FrameRingBuffer &operator=(const FrameRingBuffer &) = delete;
+
+  /// Copy a frame into the next slot, overwriting the oldest one
+  void push(const cv::Mat &frame);
+
+  /// Take the newest unconsumed frame, waiting up to timeout for one.
+  /// The frame's buffer is moved out, so the caller owns it afterwards.
+  [[nodiscard]] bool popLatest(CapturedFrame &frame,
+                               std::chrono::milliseconds timeout);
+
+  /// Wake up a waiting consumer and make further pops return immediately
+  void close();
+
+  [[nodiscard]] bool isClosed() const;
+  [[nodiscard]] std::size_t capacity() const { return slots_.size(); }
+  [[nodiscard]] std::uint64_t pushedCount() const;
+  [[nodiscard]] std::uint64_t consumedCount() const;
+  [[nodiscard]] std::uint64_t droppedCount() const;
+
+private:
+  std::vector<CapturedFrame> slots_;
+  mutable std::mutex mutex_;
+  std::condition_variable frameAvailable_;
+  std::uint64_t pushed_{0};
+  std::uint64_t consumed_{0};
+  std::uint64_t dropped_{0};
+  std::uint64_t lastConsumedSequence_{0};
+  bool closed_{false};
+};
+
+} // namespace capture
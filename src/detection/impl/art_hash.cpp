@@ -0,0 +1,105 @@
+#include <art_hash.hpp>
+#include <libassert/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+namespace detect {
+
+namespace {
+// Art hash window (relative to the normalized card)
+constexpr double hash_left_ratio = 0.12;   // 12% from left
+constexpr double hash_top_ratio = 0.14;    // 14% from top
+constexpr double hash_width_ratio = 0.76;  // 76% of card width
+constexpr double hash_height_ratio = 0.36; // 36% of card height
+
+constexpr int hash_side = 8;   // 8x8 bits per hash
+constexpr int dct_side = 32;   // pHash input size
+constexpr int hex_digits = 32; // Two 64-bit words
+
+std::uint64_t differenceHash(const cv::Mat &gray) {
+  // One extra column so every bit compares a pixel with its right neighbor
+  cv::Mat small;
+  cv::resize(gray, small, cv::Size(hash_side + 1, hash_side), 0, 0,
+             cv::INTER_AREA);
+
+  std::uint64_t hash = 0;
+  for (int y = 0; y < hash_side; ++y) {
+    const auto *row = small.ptr<std::uint8_t>(y);
+    for (int x = 0; x < hash_side; ++x) {
+      hash = (hash << 1) | static_cast<std::uint64_t>(row[x] < row[x + 1]);
+    }
+  }
+  return hash;
+}
+
+std::uint64_t dctHash(const cv::Mat &gray) {
+  cv::Mat small;
+  cv::resize(gray, small, cv::Size(dct_side, dct_side), 0, 0, cv::INTER_AREA);
+  small.convertTo(small, CV_32F);
+  cv::Mat frequencies;
+  cv::dct(small, frequencies);
+
+  // Lowest 8x8 frequencies against their median; the DC term is left out
+  // of the median so overall brightness does not shift it
+  cv::Mat low = frequencies(cv::Rect(0, 0, hash_side, hash_side)).clone();
+  std::vector<float> values(low.begin<float>() + 1, low.end<float>());
+  auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size()) / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  float median = *middle;
+
+  std::uint64_t hash = 0;
+  for (auto it = low.begin<float>(); it != low.end<float>(); ++it) {
+    hash = (hash << 1) | static_cast<std::uint64_t>(*it > median);
+  }
+  return hash;
+}
+} // namespace
+
+cv::Rect artHashRegion(const cv::Mat &card) {
+  int x = static_cast<int>(card.cols * hash_left_ratio);
+  int y = static_cast<int>(card.rows * hash_top_ratio);
+  int width = static_cast<int>(card.cols * hash_width_ratio);
+  int height = static_cast<int>(card.rows * hash_height_ratio);
+
+  return {x, y, width, height};
+}
+
+ArtHash computeArtHash(const cv::Mat &art) {
+  ASSERT(!art.empty(), "Art image is empty");
+  cv::Mat gray;
+  if (art.channels() == 1) {
+    gray = art;
+  } else {
+    cv::cvtColor(art, gray, cv::COLOR_BGR2GRAY);
+  }
+
+  ArtHash hash;
+  hash.dHash = differenceHash(gray);
+  hash.pHash = dctHash(gray);
+  return hash;
+}
+
+std::string toHex(const ArtHash &hash) {
+  char buffer[hex_digits + 1];
+  std::snprintf(buffer, sizeof(buffer), "%016llx%016llx",
+                static_cast<unsigned long long>(hash.dHash),
+                static_cast<unsigned long long>(hash.pHash));
+  return buffer;
+}
+
+ArtHash artHashFromHex(const std::string &hex) {
+  if (hex.size() != hex_digits ||
+      hex.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos) {
+    throw std::invalid_argument("Invalid art hash: " + hex);
+  }
+  ArtHash hash;
+  hash.dHash = std::stoull(hex.substr(0, hex_digits / 2), nullptr, 16);
+  hash.pHash = std::stoull(hex.substr(hex_digits / 2), nullptr, 16);
+  return hash;
+}
+
+} // namespace detect
@@ -0,0 +1,113 @@
+#include <art_index.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace detect {
+
+namespace {
+constexpr const char *index_header = "# card art index v1";
+} // namespace
+
+void ArtIndex::add(std::string id, const ArtHash &hash) {
+  Node node{hash, std::move(id), {}};
+  if (nodes_.empty()) {
+    nodes_.push_back(std::move(node));
+    return;
+  }
+
+  // Walk down the edge labelled with our distance until it is free
+  std::size_t current = 0;
+  while (true) {
+    int distance = hammingDistance(nodes_[current].hash, hash);
+    auto &children = nodes_[current].children;
+    auto child = std::find_if(children.begin(), children.end(),
+                              [distance](const auto &edge) {
+                                return edge.first == distance;
+                              });
+    if (child == children.end()) {
+      children.emplace_back(distance, nodes_.size());
+      nodes_.push_back(std::move(node));
+      return;
+    }
+    current = child->second;
+  }
+}
+
+std::vector<ArtMatch> ArtIndex::query(const ArtHash &hash,
+                                      int maxDistance) const {
+  std::vector<ArtMatch> matches;
+  if (nodes_.empty()) {
+    return matches;
+  }
+
+  std::vector<std::size_t> pending{0};
+  while (!pending.empty()) {
+    const auto &node = nodes_[pending.back()];
+    pending.pop_back();
+
+    int distance = hammingDistance(node.hash, hash);
+    if (distance <= maxDistance) {
+      matches.push_back({node.id, distance});
+    }
+    for (const auto &[edge, child] : node.children) {
+      if (edge >= distance - maxDistance && edge <= distance + maxDistance) {
+        pending.push_back(child);
+      }
+    }
+  }
+
+  std::sort(matches.begin(), matches.end(),
+            [](const ArtMatch &a, const ArtMatch &b) {
+              return a.distance != b.distance ? a.distance < b.distance
+                                              : a.id < b.id;
+            });
+  return matches;
+}
+
+void ArtIndex::save(const std::filesystem::path &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot write art index: " + path.string());
+  }
+  // Insertion order, so loading rebuilds the same tree
+  file << index_header << '\n';
+  for (const auto &node : nodes_) {
+    file << node.id << ' ' << toHex(node.hash) << '\n';
+  }
+}
+
+ArtIndex ArtIndex::load(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot read art index: " + path.string());
+  }
+
+  ArtIndex index;
+  std::string line;
+  int line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string id;
+    std::string hex;
+    if (!(fields >> id >> hex)) {
+      throw std::runtime_error("Malformed art index line " +
+                               std::to_string(line_number));
+    }
+    try {
+      index.add(std::move(id), artHashFromHex(hex));
+    } catch (const std::invalid_argument &e) {
+      throw std::runtime_error(std::string(e.what()) + " on line " +
+                               std::to_string(line_number));
+    }
+  }
+  return index;
+}
+
+} // namespace detect
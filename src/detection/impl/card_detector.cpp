@@ -2,9 +2,11 @@
 #include <array>
 #include <card_detector.hpp>
 #include <cmath>
+#include <cstddef>
 #include <libassert/assert.hpp>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <utility>
 
 namespace detect {
 
@@ -12,9 +14,13 @@ namespace {
 // Card detection thresholds
 constexpr double min_card_area_ratio =
     0.1; // Card must be at least 10% of image
-constexpr double card_aspect_ratio = 0.714; // Standard MTG card ratio (2.5/3.5)
-constexpr double aspect_ratio_tolerance = 0.2;
+constexpr double min_page_card_area_ratio =
+    0.02; // Binder page: up to 3x3 cards plus sleeves and margins
 constexpr double contour_approx_epsilon = 0.02;
+// A card contour nested in another one and at least this share of its area
+// is the inner edge of the same card's border; a smaller one makes the
+// outer contour an enclosure (page, sleeve or pocket outline)
+constexpr double same_card_area_ratio = 0.5;
 
 // Image processing constants
 constexpr int blur_ratio = 100;  // Divisor for calculating blur kernel size
@@ -127,10 +133,9 @@ cv::Mat warpCard(const std::vector<cv::Point2f> &corners,
   return warped;
 }
 
-bool detectCards(const cv::Mat &undistortedImage,
-                 std::vector<cv::Mat> &processed_cards) {
-  processed_cards.clear();
-
+std::vector<std::vector<cv::Point>>
+findCardContours(const cv::Mat &undistortedImage, double minAreaRatio,
+                 bool nested) {
   // Calculate dynamic parameters based on image size
   int min_dim = std::min(undistortedImage.cols, undistortedImage.rows);
   int blur_radius =
@@ -172,13 +177,10 @@ bool detectCards(const cv::Mat &undistortedImage,
   // Find contours with modified parameters
   std::vector<std::vector<cv::Point>> contours;
   std::vector<cv::Vec4i> hierarchy;
-  cv::findContours(morphed, contours, hierarchy, cv::RETR_EXTERNAL,
+  cv::findContours(morphed, contours, hierarchy,
+                   nested ? cv::RETR_TREE : cv::RETR_EXTERNAL,
                    cv::CHAIN_APPROX_SIMPLE);
 
-  if (contours.empty()) {
-    return false;
-  }
-
   // Filter contours by area and aspect ratio
   std::vector<std::vector<cv::Point>> valid_contours;
   for (const auto &contour : contours) {
@@ -187,55 +189,167 @@ bool detectCards(const cv::Mat &undistortedImage,
     double aspect_ratio =
         static_cast<double>(bound_rect.width) / bound_rect.height;
 
-    if (area > min_card_area_ratio * min_dim * min_dim &&
-        std::abs(aspect_ratio - card_aspect_ratio) < aspect_ratio_tolerance) {
+    if (area > minAreaRatio * min_dim * min_dim &&
+        std::abs(aspect_ratio - cardAspectRatio) < aspectRatioTolerance) {
       valid_contours.push_back(contour);
     }
   }
 
-  if (valid_contours.empty()) {
-    return false;
+  return valid_contours;
+}
+
+void removeNestedContours(std::vector<std::vector<cv::Point>> &contours) {
+  std::vector<double> areas;
+  areas.reserve(contours.size());
+  for (const auto &contour : contours) {
+    areas.push_back(cv::contourArea(contour));
   }
 
-  // Find the contour with maximum area among valid contours
-  auto max_contour = std::max_element(
-      valid_contours.begin(), valid_contours.end(),
-      [](const std::vector<cv::Point> &c1, const std::vector<cv::Point> &c2) {
-        return cv::contourArea(c1) < cv::contourArea(c2);
-      });
+  std::vector<bool> dropped(contours.size(), false);
+  for (std::size_t outer = 0; outer < contours.size(); ++outer) {
+    for (std::size_t inner = 0; inner < contours.size(); ++inner) {
+      if (inner == outer || areas[inner] >= areas[outer]) {
+        continue;
+      }
+      cv::Rect bounds = cv::boundingRect(contours[inner]);
+      cv::Point2f center(static_cast<float>(bounds.x) + bounds.width / 2.0F,
+                         static_cast<float>(bounds.y) + bounds.height / 2.0F);
+      if (cv::pointPolygonTest(contours[outer], center, false) < 0) {
+        continue;
+      }
+      if (areas[inner] >= same_card_area_ratio * areas[outer]) {
+        dropped[inner] = true; // Inner edge of the same card's border
+      } else {
+        dropped[outer] = true; // Encloses smaller cards
+      }
+    }
+  }
 
+  std::vector<std::vector<cv::Point>> kept;
+  for (std::size_t i = 0; i < contours.size(); ++i) {
+    if (!dropped[i]) {
+      kept.push_back(std::move(contours[i]));
+    }
+  }
+  contours = std::move(kept);
+}
+
+std::vector<cv::Point2f>
+contourCorners(const std::vector<cv::Point> &contour) {
   // Approximate the contour to get corners
   std::vector<cv::Point> approx_curve;
-  double epsilon = contour_approx_epsilon * cv::arcLength(*max_contour, true);
-  cv::approxPolyDP(*max_contour, approx_curve, epsilon, true);
+  double epsilon = contour_approx_epsilon * cv::arcLength(contour, true);
+  cv::approxPolyDP(contour, approx_curve, epsilon, true);
 
   // Check if we have a valid quadrilateral
+  std::vector<cv::Point2f> corners;
   if (approx_curve.size() == 4 && cv::isContourConvex(approx_curve)) {
-    std::vector<cv::Point2f> corners;
     corners.reserve(approx_curve.size()); // Pre-allocate capacity
     std::transform(approx_curve.begin(), approx_curve.end(),
                    std::back_inserter(corners), [](const cv::Point &point) {
                      return cv::Point2f(static_cast<float>(point.x),
                                         static_cast<float>(point.y));
                    });
-
-    // Sort corners and warp the card
-    cv::Mat warped = warpCard(corners, undistortedImage);
-    if (!warped.empty()) {
-      processed_cards.push_back(warped);
-      return true;
-    }
+    return sortCorners(corners);
   }
 
   // Alternative: If approximation didn't work, try using the bounding rect
-  cv::RotatedRect bounding_box = cv::minAreaRect(*max_contour);
+  cv::RotatedRect bounding_box = cv::minAreaRect(contour);
   std::array<cv::Point2f, 4> vertices;
   bounding_box.points(vertices.data());
 
-  std::vector<cv::Point2f> corners;
   corners.reserve(4); // Pre-allocate capacity
   std::copy(vertices.begin(), vertices.end(), std::back_inserter(corners));
+  return sortCorners(corners);
+}
+
+bool findCardCorners(const cv::Mat &undistortedImage,
+                     std::vector<cv::Point2f> &corners) {
+  corners.clear();
+
+  auto valid_contours =
+      findCardContours(undistortedImage, min_card_area_ratio);
+  if (valid_contours.empty()) {
+    return false;
+  }
+
+  // Find the contour with maximum area among valid contours
+  auto max_contour = std::max_element(
+      valid_contours.begin(), valid_contours.end(),
+      [](const std::vector<cv::Point> &c1, const std::vector<cv::Point> &c2) {
+        return cv::contourArea(c1) < cv::contourArea(c2);
+      });
+
+  corners = contourCorners(*max_contour);
+  return true;
+}
+
+bool findAllCardCorners(const cv::Mat &undistortedImage,
+                        std::vector<std::vector<cv::Point2f>> &cards) {
+  cards.clear();
+
+  // Cards on a binder page are much smaller relative to the frame. The
+  // page or sleeve outline is card-shaped too, so nested contours are
+  // searched and the ones enclosing other cards dropped.
+  auto contours =
+      findCardContours(undistortedImage, min_page_card_area_ratio, true);
+  removeNestedContours(contours);
+  for (const auto &contour : contours) {
+    cards.push_back(contourCorners(contour));
+  }
+  sortReadingOrder(cards);
+  return !cards.empty();
+}
+
+void sortReadingOrder(std::vector<std::vector<cv::Point2f>> &cards) {
+  if (cards.empty()) {
+    return;
+  }
+
+  // Cards whose centers are less than half a card height apart share a row
+  std::vector<float> heights;
+  heights.reserve(cards.size());
+  for (const auto &card : cards) {
+    heights.push_back(static_cast<float>(cv::boundingRect(card).height));
+  }
+  auto median =
+      heights.begin() + static_cast<std::ptrdiff_t>(heights.size() / 2);
+  std::nth_element(heights.begin(), median, heights.end());
+  const float row_tolerance = *median / 2.0F;
+
+  auto center = [](const std::vector<cv::Point2f> &card) {
+    return (card[0] + card[1] + card[2] + card[3]) / 4.0F;
+  };
+  std::sort(cards.begin(), cards.end(),
+            [&](const std::vector<cv::Point2f> &a,
+                const std::vector<cv::Point2f> &b) {
+              return center(a).y < center(b).y;
+            });
+
+  auto row_start = cards.begin();
+  for (auto it = cards.begin(); it != cards.end(); ++it) {
+    if (center(*it).y - center(*row_start).y > row_tolerance) {
+      std::sort(row_start, it, [&](const auto &a, const auto &b) {
+        return center(a).x < center(b).x;
+      });
+      row_start = it;
+    }
+  }
+  std::sort(row_start, cards.end(), [&](const auto &a, const auto &b) {
+    return center(a).x < center(b).x;
+  });
+}
 
+bool detectCards(const cv::Mat &undistortedImage,
+                 std::vector<cv::Mat> &processed_cards) {
+  processed_cards.clear();
+
+  std::vector<cv::Point2f> corners;
+  if (!findCardCorners(undistortedImage, corners)) {
+    return false;
+  }
+
+  // Warp the card
   cv::Mat warped = warpCard(corners, undistortedImage);
   if (!warped.empty()) {
     processed_cards.push_back(warped);
@@ -250,18 +364,48 @@ bool detectCards(const cv::Mat &undistortedImage,
 cv::Mat processCards(const std::filesystem::path &imagePath) {
   cv::Mat original_image;
   cv::Mat undistorted_image;
-  std::vector<cv::Mat> processed_cards;
 
   ASSERT(!imagePath.empty(), "Image path is empty in process_cards");
   if (!detail::loadImage(imagePath, original_image, undistorted_image)) {
     throw std::runtime_error("Failed to load image");
   }
 
-  if (undistorted_image.empty()) {
+  return processFrame(undistorted_image);
+}
+
+std::vector<DetectedCard> processAllCards(const cv::Mat &frame) {
+  if (frame.empty()) {
+    throw std::runtime_error("no cards");
+  }
+
+  cv::Mat undistorted_image = frame;
+  detail::undistortImage(undistorted_image);
+
+  std::vector<std::vector<cv::Point2f>> quads;
+  std::vector<DetectedCard> cards;
+  if (!detail::findAllCardCorners(undistorted_image, quads)) {
+    return cards;
+  }
+
+  cards.reserve(quads.size());
+  for (auto &corners : quads) {
+    cv::Mat warped = detail::warpCard(corners, undistorted_image);
+    if (!warped.empty()) {
+      cards.push_back({warped, std::move(corners)});
+    }
+  }
+  return cards;
+}
+
+cv::Mat processFrame(const cv::Mat &frame) {
+  std::vector<cv::Mat> processed_cards;
+
+  if (frame.empty()) {
     throw std::runtime_error("no cards");
   }
 
   // Step 1: Undistort the image if you have calibration (no-op here)
+  cv::Mat undistorted_image = frame;
   detail::undistortImage(undistorted_image);
 
   // Step 2: Detect all cards
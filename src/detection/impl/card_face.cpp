@@ -0,0 +1,104 @@
+#include <card_face.hpp>
+#include <libassert/assert.hpp>
+
+namespace detect {
+
+namespace {
+constexpr int border_inset = 1;           // Skip the outermost row (bleed)
+constexpr double center_fraction = 0.5;   // Central part holding the oval
+constexpr int center_min_saturation = 60; // Grey pixels are not "blue"
+
+cv::Mat thumbnailOf(const cv::Mat &image) {
+  cv::Mat thumbnail;
+  cv::resize(image, thumbnail,
+             cv::Size(CardFaceClassifier::thumbnailWidth,
+                      CardFaceClassifier::thumbnailHeight),
+             0, 0, cv::INTER_AREA);
+  return thumbnail;
+}
+
+cv::Mat toGray(const cv::Mat &image) {
+  if (image.channels() == 1) {
+    return image;
+  }
+  cv::Mat gray;
+  cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+  return gray;
+}
+} // namespace
+
+CardFaceClassifier::CardFaceClassifier(FaceConfig config) : config_(config) {}
+
+void CardFaceClassifier::setBackTemplate(const cv::Mat &cardBack) {
+  ASSERT(!cardBack.empty(), "Card back template is empty");
+  backTemplate_ = toGray(thumbnailOf(cardBack));
+}
+
+bool CardFaceClassifier::hasBackColors(const cv::Mat &thumbnail) const {
+  if (thumbnail.channels() != 3) {
+    return false;
+  }
+  cv::Mat hsv;
+  cv::cvtColor(thumbnail, hsv, cv::COLOR_BGR2HSV);
+
+  // One-pixel ring just inside the edge
+  cv::Mat ring(hsv.size(), CV_8UC1, cv::Scalar(0));
+  cv::rectangle(ring,
+                cv::Rect(border_inset, border_inset,
+                         hsv.cols - 2 * border_inset,
+                         hsv.rows - 2 * border_inset),
+                cv::Scalar(255), 1);
+  cv::Scalar border = cv::mean(hsv, ring);
+  bool brown_border = border[0] >= config_.backBorderMinHue &&
+                      border[0] <= config_.backBorderMaxHue &&
+                      border[1] >= config_.backBorderMinSaturation &&
+                      border[2] >= config_.backBorderMinValue;
+  if (!brown_border) {
+    return false;
+  }
+
+  cv::Rect center(
+      static_cast<int>(hsv.cols * (1.0 - center_fraction) / 2.0),
+      static_cast<int>(hsv.rows * (1.0 - center_fraction) / 2.0),
+      static_cast<int>(hsv.cols * center_fraction),
+      static_cast<int>(hsv.rows * center_fraction));
+  cv::Mat blue;
+  cv::inRange(hsv(center),
+              cv::Scalar(config_.backCenterMinHue, center_min_saturation,
+                         config_.backBorderMinValue),
+              cv::Scalar(config_.backCenterMaxHue, 255, 255), blue);
+  double blue_ratio = static_cast<double>(cv::countNonZero(blue)) /
+                      static_cast<double>(blue.total());
+  return blue_ratio >= config_.backCenterMinBlueRatio;
+}
+
+FaceDecision CardFaceClassifier::classify(const cv::Mat &warpedCard) const {
+  ASSERT(!warpedCard.empty(), "Card image is empty");
+  FaceDecision decision;
+  cv::Mat thumbnail = thumbnailOf(warpedCard);
+  cv::Mat gray = toGray(thumbnail);
+
+  cv::Scalar mean;
+  cv::Scalar stddev;
+  cv::meanStdDev(gray, mean, stddev);
+  decision.stddev = stddev[0];
+  if (decision.stddev < config_.minCardStddev) {
+    decision.face = CardFace::notACard;
+    return decision;
+  }
+
+  bool back = false;
+  if (hasBackTemplate()) {
+    // Same size as the template, so matchTemplate yields a single score
+    cv::Mat score;
+    cv::matchTemplate(gray, backTemplate_, score, cv::TM_CCOEFF_NORMED);
+    decision.correlation = score.at<float>(0, 0);
+    back = decision.correlation >= config_.backMinCorrelation;
+  } else {
+    back = hasBackColors(thumbnail);
+  }
+  decision.face = back ? CardFace::back : CardFace::front;
+  return decision;
+}
+
+} // namespace detect
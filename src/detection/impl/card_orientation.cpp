@@ -0,0 +1,62 @@
+#include <card_orientation.hpp>
+#include <libassert/assert.hpp>
+
+#include <algorithm>
+
+namespace detect {
+
+namespace {
+struct BandScores {
+  double brightness{0.0};
+  double ink{0.0};
+};
+
+BandScores scoreBand(const cv::Mat &gray, const cv::Rect &band,
+                     int inkContrast) {
+  cv::Mat region = gray(band);
+  BandScores scores;
+  scores.brightness = cv::mean(region)[0];
+
+  // Text is whatever stands out from the bar it is printed on, dark on the
+  // name bar and light on the info strip
+  cv::Mat distance;
+  cv::absdiff(region, cv::Scalar(scores.brightness), distance);
+  scores.ink = static_cast<double>(cv::countNonZero(distance > inkContrast)) /
+               static_cast<double>(region.total());
+  return scores;
+}
+} // namespace
+
+OrientationScores assessOrientation(const cv::Mat &card,
+                                    const OrientationConfig &config) {
+  ASSERT(!card.empty(), "Card image is empty");
+
+  cv::Mat gray;
+  if (card.channels() == 1) {
+    gray = card;
+  } else {
+    cv::cvtColor(card, gray, cv::COLOR_BGR2GRAY);
+  }
+
+  int inset = static_cast<int>(gray.cols * config.bandInset);
+  int top = static_cast<int>(gray.rows * config.bandTop);
+  int height = std::max(1, static_cast<int>(gray.rows * config.bandHeight));
+  cv::Rect top_band(inset, top, gray.cols - 2 * inset, height);
+  cv::Rect bottom_band(inset, gray.rows - top - height, gray.cols - 2 * inset,
+                       height);
+
+  auto upper = scoreBand(gray, top_band, config.inkContrast);
+  auto lower = scoreBand(gray, bottom_band, config.inkContrast);
+
+  OrientationScores scores;
+  scores.topBrightness = upper.brightness;
+  scores.bottomBrightness = lower.brightness;
+  scores.topInk = upper.ink;
+  scores.bottomInk = lower.ink;
+  scores.upsideDown =
+      lower.brightness - upper.brightness > config.minBrightnessGap &&
+      lower.ink - upper.ink > config.minInkGap;
+  return scores;
+}
+
+} // namespace detect
@@ -1,40 +1,308 @@
 #include <card_text_ocr.hpp>
 #include <leptonica/allheaders.h>
+#include <process_memory.hpp>
 #include <spdlog/spdlog.h>
 #include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace detect {
 
-cv::Mat preprocessForOcr(const cv::Mat &image) {
-  cv::Mat processed;
+namespace {
+// An engine checked out of the pool; returned to it when destroyed
+using Engine = std::unique_ptr<tesseract::TessBaseAPI,
+                               std::function<void(tesseract::TessBaseAPI *)>>;
+
+// Engines are interchangeable if they load the same traineddata the same way
+struct EngineKey {
+  std::string tessdata; // Empty: Tesseract's own TESSDATA_PREFIX lookup
+  std::string language;
+  int engineMode{tesseract::OEM_DEFAULT};
+
+  bool operator<(const EngineKey &other) const {
+    return std::tie(tessdata, language, engineMode) <
+           std::tie(other.tessdata, other.language, other.engineMode);
+  }
+};
+
+// Tessdata directory of a profile model name
+std::string tessdataPath(const std::string &model) {
+  if (model == "best") {
+#ifdef TESSDATA_PREFIX
+    return TESSDATA_PREFIX;
+#else
+    return "";
+#endif
+  }
+  if (model == "fast") {
+#ifdef TESSDATA_FAST_PREFIX
+    return TESSDATA_FAST_PREFIX;
+#else
+    return tessdataPath("best"); // Built without tessdata_fast
+#endif
+  }
+  return model;
+}
+
+// Initialized Tesseract engines per model, reused across calls. Init loads
+// the traineddata and used to dominate every OCR call. Each caller checks
+// out its own engine, so region OCR on several threads never shares one;
+// the pool grows to the largest number of concurrent callers.
+class EnginePool {
+public:
+  EnginePool() = default;
+  EnginePool(const EnginePool &) = delete;
+  EnginePool &operator=(const EnginePool &) = delete;
+
+  ~EnginePool() {
+    for (auto &[key, engines] : idle_) {
+      for (auto &engine : engines) {
+        engine->End();
+      }
+    }
+  }
+
+  // Empty if Tesseract cannot be initialized with the field's model
+  [[nodiscard]] Engine acquire(const FieldOcrSettings &settings) {
+    EngineKey key{tessdataPath(settings.model), settings.language,
+                  settings.engineMode};
+    std::unique_ptr<tesseract::TessBaseAPI> engine;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &idle = idle_[key];
+      if (!idle.empty()) {
+        engine = std::move(idle.back());
+        idle.pop_back();
+      }
+    }
+
+    if (!engine) {
+      engine = std::make_unique<tesseract::TessBaseAPI>();
+      if (!initialize(*engine, key)) {
+        spdlog::error("Failed to initialize Tesseract with language {} "
+                      "(model {}, engine mode {})",
+                      key.language, settings.model, key.engineMode);
+        return Engine(nullptr, [](tesseract::TessBaseAPI * /*engine*/) {});
+      }
+      spdlog::debug("Tesseract engine for {} ({}) ready, {} MB resident",
+                    key.language, settings.model,
+                    misc::readProcessMemory().residentKb / 1024);
+    }
+
+    return Engine(engine.release(),
+                  [this, key](tesseract::TessBaseAPI *released) {
+                    release(key, released);
+                  });
+  }
+
+private:
+  bool initialize(tesseract::TessBaseAPI &engine, const EngineKey &key) {
+    auto mode = static_cast<tesseract::OcrEngineMode>(key.engineMode);
+    const char *tessdata =
+        key.tessdata.empty() ? nullptr : key.tessdata.c_str();
+    return engine.Init(tessdata, key.language.c_str(), mode) == 0;
+  }
 
-  // Convert to grayscale if the image is in color
+  void release(const EngineKey &key, tesseract::TessBaseAPI *engine) {
+    engine->Clear(); // Drop the last image and results, keep the model
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_[key].emplace_back(engine);
+  }
+
+  std::mutex mutex_; // Guards idle_
+  std::map<EngineKey, std::vector<std::unique_ptr<tesseract::TessBaseAPI>>>
+      idle_;
+};
+
+EnginePool &enginePool() {
+  static EnginePool pool;
+  return pool;
+}
+
+// The legacy path's 9 pixel bilateral kernel at 3x covers 3 native pixels
+constexpr int native_filter_diameter = 3;
+
+int interpolationFlag(OcrInterpolation interpolation) {
+  switch (interpolation) {
+  case OcrInterpolation::linear:
+    return cv::INTER_LINEAR;
+  case OcrInterpolation::lanczos:
+    return cv::INTER_LANCZOS4;
+  case OcrInterpolation::cubic:
+    break;
+  }
+  return cv::INTER_CUBIC;
+}
+
+cv::Mat grayscale(const cv::Mat &image) {
+  cv::Mat gray;
   if (image.channels() == 3) {
-    cv::cvtColor(image, processed, cv::COLOR_BGR2GRAY);
+    cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
   } else {
-    processed = image.clone();
+    gray = image.clone();
   }
+  return gray;
+}
 
-  // Scale up first for better detail preservation (3x for small text regions)
-  cv::resize(processed, processed, cv::Size(), 3.0, 3.0, cv::INTER_CUBIC);
-
-  // Apply bilateral filter to reduce noise while preserving edges
+cv::Mat denoise(const cv::Mat &gray, OcrFilter filter, int diameter) {
   cv::Mat filtered;
-  cv::bilateralFilter(processed, filtered, 9, 75, 75);
+  switch (filter) {
+  case OcrFilter::bilateral:
+    // Reduces noise while preserving edges
+    cv::bilateralFilter(gray, filtered, diameter, 75, 75);
+    break;
+  case OcrFilter::median:
+    cv::medianBlur(gray, filtered, 3);
+    break;
+  case OcrFilter::none:
+    filtered = gray;
+    break;
+  }
+  return filtered;
+}
 
-  // Use Otsu's thresholding for better automatic threshold selection
+// Text is dark on light if at least half of the binary image is white
+bool darkOnLight(const cv::Mat &binary) {
+  return cv::countNonZero(binary) >= binary.rows * binary.cols / 2;
+}
+
+// Grayscale, upscale, denoise and Otsu threshold, inverted if needed so
+// the text is dark on light. The filter runs on up to 25x the pixels.
+cv::Mat binarizeUpscaled(const cv::Mat &image,
+                         const FieldOcrSettings &settings) {
+  cv::Mat processed = grayscale(image);
+  cv::resize(processed, processed, cv::Size(), settings.scale, settings.scale,
+             interpolationFlag(settings.interpolation));
+
+  cv::Mat filtered = denoise(processed, settings.filter, 9);
   cv::threshold(filtered, processed, 0, 255,
                 cv::THRESH_BINARY | cv::THRESH_OTSU);
-
-  // Invert if the text appears to be light on dark background
-  // (check if more than 50% of pixels are dark)
-  int non_zero_count = cv::countNonZero(processed);
-  int total_pixels = processed.rows * processed.cols;
-  if (non_zero_count < total_pixels / 2) {
+  if (!darkOnLight(processed)) {
     cv::bitwise_not(processed, processed);
   }
+  return processed;
+}
+
+// Same result, but denoising, Otsu's threshold and the polarity check run
+// at native resolution. Only the upscale and an in-place fixed threshold
+// touch the large image, both OpenCV SIMD kernels. Thresholding after the
+// interpolation keeps the stroke edges smooth.
+cv::Mat binarizeNative(const cv::Mat &image,
+                       const FieldOcrSettings &settings) {
+  cv::Mat filtered =
+      denoise(grayscale(image), settings.filter, native_filter_diameter);
+
+  cv::Mat binary;
+  double level = cv::threshold(filtered, binary, 0, 255,
+                               cv::THRESH_BINARY | cv::THRESH_OTSU);
+  int type = darkOnLight(binary) ? cv::THRESH_BINARY : cv::THRESH_BINARY_INV;
+
+  cv::Mat processed;
+  cv::resize(filtered, processed, cv::Size(), settings.scale, settings.scale,
+             interpolationFlag(settings.interpolation));
+  cv::threshold(processed, processed, level, 255, type);
+  return processed;
+}
+
+cv::Mat binarize(const cv::Mat &image, const FieldOcrSettings &settings) {
+  if (settings.preprocessing == OcrPreprocessing::legacy) {
+    return binarizeUpscaled(image, settings);
+  }
+  return binarizeNative(image, settings);
+}
+
+// Text of the current image or rectangle
+std::string recognizedText(tesseract::TessBaseAPI &tess) {
+  std::unique_ptr<char, decltype(&std::free)> out_text(tess.GetUTF8Text(),
+                                                       &std::free);
+  return out_text ? std::string(out_text.get()) : "";
+}
+
+// Alternatives of every uppercase letter of the last recognition. Needs
+// lstm_choice_mode 2, or the LSTM engine reports only the best character.
+std::vector<std::vector<CharChoice>>
+letterChoices(tesseract::TessBaseAPI &tess) {
+  std::vector<std::vector<CharChoice>> choices;
+  std::unique_ptr<tesseract::ResultIterator> symbols(tess.GetIterator());
+  if (!symbols || symbols->Empty(tesseract::RIL_SYMBOL)) {
+    return choices;
+  }
+  do {
+    std::vector<CharChoice> position;
+    tesseract::ChoiceIterator choice(*symbols);
+    do {
+      const char *text = choice.GetUTF8Text();
+      if (text != nullptr && text[0] >= 'A' && text[0] <= 'Z' &&
+          text[1] == '\0') {
+        position.push_back({text[0], choice.Confidence()});
+      }
+    } while (choice.Next());
+    if (!position.empty()) {
+      std::stable_sort(position.begin(), position.end(),
+                       [](const CharChoice &a, const CharChoice &b) {
+                         return a.confidence > b.confidence;
+                       });
+      choices.push_back(std::move(position));
+    }
+  } while (symbols->Next(tesseract::RIL_SYMBOL));
+  // Same limit as the text
+  if (choices.size() > 3) {
+    choices.resize(3);
+  }
+  return choices;
+}
+
+std::string setCodeLetters(const std::string &raw) {
+  // Keep only uppercase letters, limit to exactly 3 chars for set code
+  std::string set_code;
+  for (char c : raw) {
+    if (c >= 'A' && c <= 'Z' && set_code.length() < 3) {
+      set_code += c;
+    }
+  }
+  return set_code;
+}
+} // namespace
+
+
+std::string normalizeCollectorNumber(const std::string &raw) {
+  // Keep only digits
+  std::string digits;
+  for (char c : raw) {
+    if (c >= '0' && c <= '9') {
+      digits += c;
+    }
+  }
+
+  // Collector numbers are exactly 3 digits (take last 3)
+  if (digits.length() > 3) {
+    digits = digits.substr(digits.length() - 3);
+  }
+
+  // Remove leading zeros (Scryfall uses numbers without leading zeros)
+  size_t first_non_zero = digits.find_first_not_of('0');
+  if (first_non_zero != std::string::npos) {
+    digits = digits.substr(first_non_zero);
+  } else if (!digits.empty()) {
+    digits = "0"; // Handle "000" case
+  }
+  return digits;
+}
+
+cv::Mat preprocessForOcr(const cv::Mat &image,
+                         const FieldOcrSettings &settings) {
+  // Upscale, denoise, Otsu threshold and dark text on light
+  cv::Mat processed = binarize(image, settings);
 
   // Light morphological operations to clean up noise
   cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2, 2));
@@ -43,34 +311,28 @@ cv::Mat preprocessForOcr(const cv::Mat &image) {
   return processed;
 }
 
-std::string extractText(const cv::Mat &image, const std::string &language) {
+OcrResult recognizeText(const cv::Mat &image,
+                        const FieldOcrSettings &settings) {
   if (image.empty()) {
     spdlog::error("Cannot extract text from empty image");
-    return "";
+    return {};
   }
 
   // Preprocess the image for better OCR results
-  cv::Mat processed = preprocessForOcr(image);
+  cv::Mat processed = preprocessForOcr(image, settings);
 
-  // Initialize Tesseract with tessdata path from build configuration
-#ifdef TESSDATA_PREFIX
-  const char *tessdata_path = TESSDATA_PREFIX;
-#else
-  const char *tessdata_path = nullptr;
-#endif
-  auto tess = std::make_unique<tesseract::TessBaseAPI>();
-  if (tess->Init(tessdata_path, language.c_str()) != 0) {
-    spdlog::error("Failed to initialize Tesseract with language: {}", language);
-    return "";
+  // Borrow an initialized engine; it goes back to the pool on return
+  auto tess = enginePool().acquire(settings);
+  if (!tess) {
+    return {};
   }
 
-  // Set page segmentation mode to single line for card text regions
-  tess->SetPageSegMode(tesseract::PSM_SINGLE_LINE);
+  // Single line for card text regions by default
+  tess->SetPageSegMode(
+      static_cast<tesseract::PageSegMode>(settings.pageSegMode));
 
   // Configure Tesseract for better accuracy on stylized text
-  tess->SetVariable(
-      "tessedit_char_whitelist",
-      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 '-,.");
+  tess->SetVariable("tessedit_char_whitelist", settings.whitelist.c_str());
   tess->SetVariable("load_system_dawg", "0");
   tess->SetVariable("load_freq_dawg", "0");
 
@@ -79,9 +341,8 @@ std::string extractText(const cv::Mat &image, const std::string &language) {
                  static_cast<int>(processed.step));
 
   // Extract text
-  std::unique_ptr<char, decltype(&std::free)> out_text(tess->GetUTF8Text(),
-                                                       &std::free);
-  std::string result = out_text ? std::string(out_text.get()) : "";
+  std::string result = recognizedText(*tess);
+  int confidence = tess->MeanTextConf();
 
   // Trim whitespace
   auto start = result.find_first_not_of(" \t\n\r");
@@ -117,156 +378,168 @@ std::string extractText(const cv::Mat &image, const std::string &language) {
     result.pop_back();
   }
 
-  tess->End();
-  return result;
+  return {result, confidence};
 }
 
-std::string extractCollectorNumber(const cv::Mat &image,
-                                   const std::string &language) {
-  if (image.empty()) {
-    return "";
-  }
-
-  cv::Mat processed;
+OcrResult recognizeText(const cv::Mat &image, const std::string &language) {
+  auto settings = defaultCardNameSettings();
+  settings.language = language;
+  return recognizeText(image, settings);
+}
 
-  // Convert to grayscale
-  if (image.channels() == 3) {
-    cv::cvtColor(image, processed, cv::COLOR_BGR2GRAY);
-  } else {
-    processed = image.clone();
+OcrResult recognizeCollectorNumber(const cv::Mat &image,
+                                   const FieldOcrSettings &settings) {
+  if (image.empty()) {
+    return {};
   }
 
   // Scale up for better digit recognition
-  cv::resize(processed, processed, cv::Size(), 4.0, 4.0, cv::INTER_CUBIC);
-
-  // Bilateral filter to preserve edges
-  cv::Mat filtered;
-  cv::bilateralFilter(processed, filtered, 9, 75, 75);
-
-  // Otsu's thresholding
-  cv::threshold(filtered, processed, 0, 255,
-                cv::THRESH_BINARY | cv::THRESH_OTSU);
+  cv::Mat processed = binarize(image, settings);
 
-  // Auto-invert if needed
-  int non_zero_count = cv::countNonZero(processed);
-  int total_pixels = processed.rows * processed.cols;
-  if (non_zero_count < total_pixels / 2) {
-    cv::bitwise_not(processed, processed);
+  auto tess = enginePool().acquire(settings);
+  if (!tess) {
+    return {};
   }
 
-#ifdef TESSDATA_PREFIX
-  const char *tessdata_path = TESSDATA_PREFIX;
-#else
-  const char *tessdata_path = nullptr;
-#endif
-  auto tess = std::make_unique<tesseract::TessBaseAPI>();
-  if (tess->Init(tessdata_path, language.c_str()) != 0) {
-    return "";
-  }
-
-  tess->SetPageSegMode(tesseract::PSM_SINGLE_LINE);
+  tess->SetPageSegMode(
+      static_cast<tesseract::PageSegMode>(settings.pageSegMode));
   // Only allow digits for collector number
-  tess->SetVariable("tessedit_char_whitelist", "0123456789");
+  tess->SetVariable("tessedit_char_whitelist", settings.whitelist.c_str());
   tess->SetVariable("load_system_dawg", "0");
   tess->SetVariable("load_freq_dawg", "0");
 
   tess->SetImage(processed.data, processed.cols, processed.rows, 1,
                  static_cast<int>(processed.step));
 
-  std::unique_ptr<char, decltype(&std::free)> out_text(tess->GetUTF8Text(),
-                                                       &std::free);
-  std::string result = out_text ? std::string(out_text.get()) : "";
-
-  // Keep only digits
-  std::string digits;
-  for (char c : result) {
-    if (c >= '0' && c <= '9') {
-      digits += c;
-    }
-  }
-
-  // Collector numbers are exactly 3 digits (take last 3)
-  if (digits.length() > 3) {
-    digits = digits.substr(digits.length() - 3);
-  }
-
-  // Remove leading zeros (Scryfall uses numbers without leading zeros)
-  size_t first_non_zero = digits.find_first_not_of('0');
-  if (first_non_zero != std::string::npos) {
-    digits = digits.substr(first_non_zero);
-  } else if (!digits.empty()) {
-    digits = "0"; // Handle "000" case
-  }
+  std::string result = recognizedText(*tess);
+  int confidence = tess->MeanTextConf();
+  return {normalizeCollectorNumber(result), confidence};
+}
 
-  tess->End();
-  return digits;
+OcrResult recognizeCollectorNumber(const cv::Mat &image,
+                                   const std::string &language) {
+  auto settings = defaultCollectorNumberSettings();
+  settings.language = language;
+  return recognizeCollectorNumber(image, settings);
 }
 
-std::string extractSetCode(const cv::Mat &image, const std::string &language) {
+OcrResult recognizeSetCode(const cv::Mat &image,
+                           const FieldOcrSettings &settings) {
   if (image.empty()) {
-    return "";
+    return {};
   }
 
-  cv::Mat processed;
+  // Scale up significantly for small text
+  cv::Mat processed = binarize(image, settings);
 
-  // Convert to grayscale
-  if (image.channels() == 3) {
-    cv::cvtColor(image, processed, cv::COLOR_BGR2GRAY);
-  } else {
-    processed = image.clone();
+  auto tess = enginePool().acquire(settings);
+  if (!tess) {
+    return {};
   }
 
-  // Scale up significantly for small text
-  cv::resize(processed, processed, cv::Size(), 5.0, 5.0, cv::INTER_LANCZOS4);
+  tess->SetPageSegMode(
+      static_cast<tesseract::PageSegMode>(settings.pageSegMode));
+  // Only uppercase letters for set codes
+  tess->SetVariable("tessedit_char_whitelist", settings.whitelist.c_str());
+  tess->SetVariable("load_system_dawg", "0");
+  tess->SetVariable("load_freq_dawg", "0");
+  tess->SetVariable("lstm_choice_mode", "2");
 
-  // Simple bilateral filter to reduce noise while preserving edges
-  cv::Mat filtered;
-  cv::bilateralFilter(processed, filtered, 9, 75, 75);
+  tess->SetImage(processed.data, processed.cols, processed.rows, 1,
+                 static_cast<int>(processed.step));
 
-  // Otsu's thresholding
-  cv::threshold(filtered, processed, 0, 255,
-                cv::THRESH_BINARY | cv::THRESH_OTSU);
+  std::string result = recognizedText(*tess);
+  int confidence = tess->MeanTextConf();
+  auto choices = letterChoices(*tess);
+  // Pooled engines keep their variables
+  tess->SetVariable("lstm_choice_mode", "0");
+  return {setCodeLetters(result), confidence, std::move(choices)};
+}
 
-  // Auto-invert if needed (text should be dark on light)
-  int non_zero_count = cv::countNonZero(processed);
-  int total_pixels = processed.rows * processed.cols;
-  if (non_zero_count < total_pixels / 2) {
-    cv::bitwise_not(processed, processed);
+OcrResult recognizeSetCode(const cv::Mat &image,
+                           const std::string &language) {
+  auto settings = defaultSetCodeSettings();
+  settings.language = language;
+  return recognizeSetCode(image, settings);
+}
+
+LookupKeyResult recognizeLookupKey(const cv::Mat &strip,
+                                   const cv::Rect &collectorBox,
+                                   const cv::Rect &setBox,
+                                   const OcrProfile &profile) {
+  if (strip.empty()) {
+    return {};
   }
 
-#ifdef TESSDATA_PREFIX
-  const char *tessdata_path = TESSDATA_PREFIX;
-#else
-  const char *tessdata_path = nullptr;
-#endif
-  auto tess = std::make_unique<tesseract::TessBaseAPI>();
-  if (tess->Init(tessdata_path, language.c_str()) != 0) {
-    return "";
+  // The whole info block is preprocessed once, with the settings of the
+  // smaller set code
+  const auto &block = profile.setCode;
+  cv::Mat processed = binarize(strip, block);
+
+  auto tess = enginePool().acquire(block);
+  if (!tess) {
+    return {};
   }
 
-  tess->SetPageSegMode(tesseract::PSM_SINGLE_WORD);
-  // Only uppercase letters for set codes
-  tess->SetVariable("tessedit_char_whitelist", "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
   tess->SetVariable("load_system_dawg", "0");
   tess->SetVariable("load_freq_dawg", "0");
-
   tess->SetImage(processed.data, processed.cols, processed.rows, 1,
                  static_cast<int>(processed.step));
 
-  std::unique_ptr<char, decltype(&std::free)> out_text(tess->GetUTF8Text(),
-                                                       &std::free);
-  std::string result = out_text ? std::string(out_text.get()) : "";
-
-  // Keep only uppercase letters, limit to exactly 3 chars for set code
-  std::string set_code;
-  for (char c : result) {
-    if (c >= 'A' && c <= 'Z' && set_code.length() < 3) {
-      set_code += c;
+  // Each field is recognized in its own rectangle of the same image
+  const cv::Rect bounds(0, 0, processed.cols, processed.rows);
+  const double scale = block.scale;
+  auto read = [&tess, &bounds, scale](const cv::Rect &box,
+                                      const FieldOcrSettings &field,
+                                      bool withChoices) -> OcrResult {
+    cv::Rect scaled(cvRound(box.x * scale), cvRound(box.y * scale),
+                    cvRound(box.width * scale), cvRound(box.height * scale));
+    scaled &= bounds;
+    if (scaled.empty()) {
+      return {};
     }
-  }
+    tess->SetPageSegMode(
+        static_cast<tesseract::PageSegMode>(field.pageSegMode));
+    tess->SetVariable("tessedit_char_whitelist", field.whitelist.c_str());
+    tess->SetVariable("lstm_choice_mode", withChoices ? "2" : "0");
+    tess->SetRectangle(scaled.x, scaled.y, scaled.width, scaled.height);
+    std::string text = recognizedText(*tess);
+    OcrResult result{text, tess->MeanTextConf()};
+    if (withChoices) {
+      result.choices = letterChoices(*tess);
+      tess->SetVariable("lstm_choice_mode", "0");
+    }
+    return result;
+  };
+
+  auto number = read(collectorBox, profile.collectorNumber, false);
+  auto set_code = read(setBox, profile.setCode, true);
+  return {{normalizeCollectorNumber(number.text), number.confidence},
+          {setCodeLetters(set_code.text), set_code.confidence,
+           std::move(set_code.choices)}};
+}
 
-  tess->End();
-  return set_code;
+LookupKeyResult recognizeLookupKey(const cv::Mat &strip,
+                                   const cv::Rect &collectorBox,
+                                   const cv::Rect &setBox,
+                                   const std::string &language) {
+  OcrProfile profile;
+  profile.collectorNumber.language = language;
+  profile.setCode.language = language;
+  return recognizeLookupKey(strip, collectorBox, setBox, profile);
+}
+
+std::string extractText(const cv::Mat &image, const std::string &language) {
+  return recognizeText(image, language).text;
+}
+
+std::string extractCollectorNumber(const cv::Mat &image,
+                                   const std::string &language) {
+  return recognizeCollectorNumber(image, language).text;
+}
+
+std::string extractSetCode(const cv::Mat &image, const std::string &language) {
+  return recognizeSetCode(image, language).text;
 }
 
 } // namespace detect
\ No newline at end of file
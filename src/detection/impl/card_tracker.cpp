@@ -0,0 +1,181 @@
+#include <card_detector.hpp>
+#include <card_tracker.hpp>
+#include <libassert/assert.hpp>
+
+#include <cmath>
+
+namespace detect {
+
+namespace {
+constexpr double min_quad_area = 400.0; // Pixels; smaller quads are noise
+
+cv::Mat grayCrop(const cv::Mat &frame, const cv::Rect &region) {
+  cv::Mat gray;
+  if (frame.channels() == 3) {
+    cv::cvtColor(frame(region), gray, cv::COLOR_BGR2GRAY);
+  } else {
+    gray = frame(region).clone();
+  }
+  return gray;
+}
+
+std::vector<cv::Point2f> shifted(const std::vector<cv::Point2f> &points,
+                                 cv::Point2f offset) {
+  std::vector<cv::Point2f> result;
+  result.reserve(points.size());
+  for (const auto &point : points) {
+    result.push_back(point + offset);
+  }
+  return result;
+}
+} // namespace
+
+CardTracker::CardTracker(TrackerConfig config) : config_(config) {
+  ASSERT(config_.roiMargin >= 0.0, "ROI margin must not be negative");
+  ASSERT(config_.flowWindow >= 3, "Flow window is too small");
+  ASSERT(config_.refreshInterval > 0, "Refresh interval must be positive");
+}
+
+void CardTracker::reset() {
+  corners_.clear();
+  region_ = {};
+  previousGray_.release();
+  framesSinceRefresh_ = 0;
+}
+
+cv::Rect CardTracker::searchRegion(cv::Size frameSize) const {
+  cv::Rect bounds = cv::boundingRect(corners_);
+  int margin_x =
+      static_cast<int>(std::lround(bounds.width * config_.roiMargin));
+  int margin_y =
+      static_cast<int>(std::lround(bounds.height * config_.roiMargin));
+  bounds.x -= margin_x;
+  bounds.y -= margin_y;
+  bounds.width += 2 * margin_x;
+  bounds.height += 2 * margin_y;
+  return bounds & cv::Rect(cv::Point(0, 0), frameSize);
+}
+
+bool CardTracker::isPlausible(const std::vector<cv::Point2f> &corners) const {
+  if (corners.size() != 4 || !cv::isContourConvex(corners) ||
+      cv::contourArea(corners) < min_quad_area) {
+    return false;
+  }
+  // Corners are TL, TR, BR, BL
+  double width =
+      (cv::norm(corners[1] - corners[0]) + cv::norm(corners[2] - corners[3])) /
+      2.0;
+  double height =
+      (cv::norm(corners[3] - corners[0]) + cv::norm(corners[2] - corners[1])) /
+      2.0;
+  return std::abs(width / height - detail::cardAspectRatio) <
+         detail::aspectRatioTolerance;
+}
+
+bool CardTracker::followCorners(const cv::Mat &frame,
+                                std::vector<cv::Point2f> &corners) const {
+  cv::Mat current_gray = grayCrop(frame, region_);
+  const cv::Point2f offset(static_cast<float>(region_.x),
+                           static_cast<float>(region_.y));
+  auto previous = shifted(corners_, -offset);
+
+  // Track forwards and back again; a corner that does not return to where it
+  // started has latched onto something else
+  std::vector<cv::Point2f> forward;
+  std::vector<cv::Point2f> backward;
+  std::vector<uchar> forward_status;
+  std::vector<uchar> backward_status;
+  std::vector<float> patch_errors;
+  std::vector<float> backward_errors;
+  const cv::Size window(config_.flowWindow, config_.flowWindow);
+  cv::calcOpticalFlowPyrLK(previousGray_, current_gray, previous, forward,
+                           forward_status, patch_errors, window,
+                           config_.flowLevels);
+  cv::calcOpticalFlowPyrLK(current_gray, previousGray_, forward, backward,
+                           backward_status, backward_errors, window,
+                           config_.flowLevels);
+
+  // A consistent track on a patch that no longer looks like the corner means
+  // the card left and the flow is following the background
+  for (std::size_t i = 0; i < previous.size(); ++i) {
+    if (forward_status[i] == 0 || backward_status[i] == 0 ||
+        cv::norm(previous[i] - backward[i]) > config_.maxFlowError ||
+        patch_errors[i] > config_.maxPatchError) {
+      return false;
+    }
+  }
+
+  corners = shifted(forward, offset);
+  if (!isPlausible(corners)) {
+    return false;
+  }
+  double previous_area = cv::contourArea(corners_);
+  double area_change =
+      std::abs(cv::contourArea(corners) - previous_area) / previous_area;
+  return area_change <= config_.maxAreaChange;
+}
+
+bool CardTracker::detectInRegion(const cv::Mat &frame,
+                                 std::vector<cv::Point2f> &corners) const {
+  cv::Rect region = searchRegion(frame.size());
+  if (region.empty() || !detail::findCardCorners(frame(region), corners)) {
+    return false;
+  }
+  corners = shifted(corners, cv::Point2f(static_cast<float>(region.x),
+                                         static_cast<float>(region.y)));
+  return isPlausible(corners);
+}
+
+void CardTracker::remember(const cv::Mat &frame,
+                           const std::vector<cv::Point2f> &corners) {
+  corners_ = corners;
+  region_ = searchRegion(frame.size());
+  if (region_.empty()) {
+    reset();
+    return;
+  }
+  previousGray_ = grayCrop(frame, region_);
+}
+
+TrackResult CardTracker::track(const cv::Mat &frame) {
+  ASSERT(!frame.empty(), "Frame is empty");
+  TrackResult result;
+
+  cv::Mat undistorted_image = frame;
+  detail::undistortImage(undistorted_image);
+
+  // Resolution changed: the previous corners mean nothing any more
+  const cv::Rect frame_rect(cv::Point(0, 0), undistorted_image.size());
+  if (isTracking() && (region_ & frame_rect) != region_) {
+    reset();
+  }
+
+  std::vector<cv::Point2f> corners;
+  if (isTracking()) {
+    bool refresh = ++framesSinceRefresh_ >= config_.refreshInterval;
+    if (!refresh && followCorners(undistorted_image, corners)) {
+      result.source = TrackSource::flow;
+    } else if (detectInRegion(undistorted_image, corners)) {
+      result.source = TrackSource::roi;
+    }
+  }
+  if (!result.found() &&
+      detail::findCardCorners(undistorted_image, corners)) {
+    result.source = TrackSource::full;
+  }
+
+  if (!result.found()) {
+    reset();
+    return result;
+  }
+  if (result.source != TrackSource::flow) {
+    framesSinceRefresh_ = 0;
+  }
+
+  result.corners = corners;
+  result.card = detail::warpCard(corners, undistorted_image);
+  remember(undistorted_image, corners);
+  return result;
+}
+
+} // namespace detect
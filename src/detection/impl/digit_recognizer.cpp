@@ -0,0 +1,248 @@
+#include <digit_recognizer.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <string>
+
+namespace detect {
+
+namespace {
+// Normalized glyph bitmap size; digits are about 3:4
+constexpr int glyph_width = 12;
+constexpr int glyph_height = 16;
+constexpr double glyph_aspect =
+    static_cast<double>(glyph_width) / glyph_height;
+
+// Rendered templates: each Hershey font that resembles a printed digit
+constexpr std::array<int, 4> template_fonts = {
+    cv::FONT_HERSHEY_SIMPLEX, cv::FONT_HERSHEY_DUPLEX,
+    cv::FONT_HERSHEY_COMPLEX, cv::FONT_HERSHEY_TRIPLEX};
+constexpr int template_canvas = 96;
+
+// Zero-mean, unit-norm float bitmap of a binary glyph (text non-zero).
+// Narrow glyphs like "1" are centered on a 3:4 canvas instead of being
+// stretched into a block.
+cv::Mat normalizeGlyph(const cv::Mat &glyph) {
+  int width = std::max(glyph.cols, cvRound(glyph.rows * glyph_aspect));
+  int height = std::max(glyph.rows, cvRound(glyph.cols / glyph_aspect));
+  cv::Mat canvas = cv::Mat::zeros(height, width, CV_8UC1);
+  glyph.copyTo(canvas(cv::Rect((width - glyph.cols) / 2,
+                               (height - glyph.rows) / 2, glyph.cols,
+                               glyph.rows)));
+
+  cv::Mat resized;
+  cv::resize(canvas, resized, cv::Size(glyph_width, glyph_height), 0, 0,
+             cv::INTER_AREA);
+  cv::Mat normalized;
+  resized.convertTo(normalized, CV_32F);
+  normalized -= cv::mean(normalized)[0];
+  double norm = cv::norm(normalized);
+  if (norm > 0.0) {
+    normalized /= norm;
+  }
+  return normalized;
+}
+
+cv::Mat renderGlyph(const std::string &text, int font) {
+  cv::Mat canvas = cv::Mat::zeros(template_canvas, template_canvas, CV_8UC1);
+  cv::putText(canvas, text, cv::Point(16, 76), font, 2.0, cv::Scalar(255), 3);
+  return normalizeGlyph(canvas(cv::boundingRect(canvas)));
+}
+
+struct Glyph {
+  cv::Rect box; // In the strip
+  cv::Mat image;
+};
+
+// Digit-sized glyphs of the strip, left to right, as binary crops
+std::vector<Glyph> segmentGlyphs(const cv::Mat &strip, double minGlyphHeight) {
+  cv::Mat gray;
+  if (strip.channels() == 3) {
+    cv::cvtColor(strip, gray, cv::COLOR_BGR2GRAY);
+  } else {
+    gray = strip;
+  }
+
+  // Text is the minority class whichever way the strip is printed
+  cv::Mat binary;
+  cv::threshold(gray, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+  if (cv::countNonZero(binary) > binary.rows * binary.cols / 2) {
+    cv::bitwise_not(binary, binary);
+  }
+
+  cv::Mat labels;
+  cv::Mat stats;
+  cv::Mat centroids;
+  int count = cv::connectedComponentsWithStats(binary, labels, stats,
+                                               centroids, 8, CV_32S);
+
+  std::vector<Glyph> glyphs;
+  int min_height = cvRound(strip.rows * minGlyphHeight);
+  for (int label = 1; label < count; ++label) {
+    cv::Rect box(stats.at<int>(label, cv::CC_STAT_LEFT),
+                 stats.at<int>(label, cv::CC_STAT_TOP),
+                 stats.at<int>(label, cv::CC_STAT_WIDTH),
+                 stats.at<int>(label, cv::CC_STAT_HEIGHT));
+    // Specks, frame edges spanning the strip and wide smears are no digits
+    if (box.height < min_height || box.height >= strip.rows ||
+        box.width > box.height * 3 / 2) {
+      continue;
+    }
+    cv::Mat crop = (labels(box) == label);
+    glyphs.push_back({box, crop});
+  }
+
+  std::sort(glyphs.begin(), glyphs.end(), [](const auto &a, const auto &b) {
+    return a.box.x < b.box.x;
+  });
+  return glyphs;
+}
+} // namespace
+
+DigitRecognizer::DigitRecognizer(DigitRecognizerConfig config)
+    : config_(config) {
+  for (int digit = 0; digit < 10; ++digit) {
+    for (int font : template_fonts) {
+      rendered_[digit].push_back(renderGlyph(std::to_string(digit), font));
+    }
+  }
+  for (int font : template_fonts) {
+    slashes_.push_back(renderGlyph("/", font));
+  }
+}
+
+DigitRecognizer::Match DigitRecognizer::classify(const cv::Mat &glyph) const {
+  cv::Mat normalized = normalizeGlyph(glyph);
+  std::array<double, 10> best{};
+  best.fill(-1.0);
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (int digit = 0; digit < 10; ++digit) {
+      for (const auto *templates : {&rendered_[digit], &learned_[digit]}) {
+        for (const auto &reference : *templates) {
+          best[digit] = std::max(best[digit], normalized.dot(reference));
+        }
+      }
+    }
+  }
+
+  Match match;
+  double runner_up = -1.0;
+  for (int digit = 0; digit < 10; ++digit) {
+    if (best[digit] > match.score) {
+      runner_up = match.score;
+      match.score = best[digit];
+      match.digit = digit;
+    } else {
+      runner_up = std::max(runner_up, best[digit]);
+    }
+  }
+  match.margin = match.score - runner_up;
+  for (const auto &reference : slashes_) {
+    match.slash = std::max(match.slash, normalized.dot(reference));
+  }
+  return match;
+}
+
+OcrResult DigitRecognizer::recognize(const cv::Mat &strip) const {
+  if (strip.empty()) {
+    return {};
+  }
+
+  auto glyphs = segmentGlyphs(strip, config_.minGlyphHeight);
+  std::string digits;
+  double worst = 1.0;
+  int number_end = 0; // Right edge of the last digit
+  for (std::size_t i = 0; i < glyphs.size(); ++i) {
+    const auto &box = glyphs[i].box;
+    auto match = classify(glyphs[i].image);
+    if (match.slash >= config_.rejectScore && match.slash > match.score) {
+      if (digits.empty()) {
+        return {}; // Nothing readable before the card total
+      }
+      break; // The card total follows the slash
+    }
+    if (match.score < config_.rejectScore) {
+      // A letter set apart from the number (rarity, language) is not part
+      // of it. Anything closer may be a digit the templates do not know
+      // yet, and dropping it would read another, valid number.
+      int gap_limit = cvRound(box.height * config_.minNumberGap);
+      if (!digits.empty() && box.x - number_end > gap_limit) {
+        break;
+      }
+      if (digits.empty() && (i + 1 == glyphs.size() ||
+                             glyphs[i + 1].box.x - box.br().x > gap_limit)) {
+        continue;
+      }
+      spdlog::debug("Unknown glyph in the collector number, using Tesseract");
+      return {normalizeCollectorNumber(digits), 0};
+    }
+    number_end = box.br().x;
+    if (match.margin < config_.minMargin) {
+      worst = 0.0; // Could be either digit; leave it to Tesseract
+    }
+    worst = std::min(worst, match.score);
+    digits += static_cast<char>('0' + match.digit);
+  }
+
+  if (digits.empty()) {
+    return {};
+  }
+  return {normalizeCollectorNumber(digits),
+          static_cast<int>(std::lround(std::max(worst, 0.0) * 100.0))};
+}
+
+bool DigitRecognizer::learn(const cv::Mat &strip,
+                            const std::string &collectorNumber) {
+  if (strip.empty() || collectorNumber.empty() ||
+      !std::all_of(collectorNumber.begin(), collectorNumber.end(),
+                   [](char c) { return c >= '0' && c <= '9'; })) {
+    return false;
+  }
+
+  // Digit glyphs only; the templates may still be too weak to tell which
+  // digit, but not to tell digits from letters
+  std::vector<cv::Mat> glyphs;
+  for (const auto &glyph : segmentGlyphs(strip, config_.minGlyphHeight)) {
+    if (classify(glyph.image).score >= config_.rejectScore) {
+      glyphs.push_back(normalizeGlyph(glyph.image));
+    }
+  }
+
+  // Printed numbers are zero-padded to three or four digits
+  if (glyphs.size() < collectorNumber.size() || glyphs.size() > 4) {
+    return false;
+  }
+  std::string printed =
+      std::string(glyphs.size() - collectorNumber.size(), '0') +
+      collectorNumber;
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  for (std::size_t i = 0; i < glyphs.size(); ++i) {
+    int digit = printed[i] - '0';
+    auto &templates = learned_[digit];
+    if (templates.size() < config_.maxLearnedPerDigit) {
+      templates.push_back(glyphs[i]);
+    } else {
+      templates[nextLearned_[digit]] = glyphs[i];
+      nextLearned_[digit] =
+          (nextLearned_[digit] + 1) % config_.maxLearnedPerDigit;
+    }
+  }
+  spdlog::debug("Learned digit glyphs of collector number {}", printed);
+  return true;
+}
+
+std::size_t DigitRecognizer::learnedCount() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  std::size_t count = 0;
+  for (const auto &templates : learned_) {
+    count += templates.size();
+  }
+  return count;
+}
+
+} // namespace detect
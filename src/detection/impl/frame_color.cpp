@@ -0,0 +1,223 @@
+#include <frame_color.hpp>
+#include <libassert/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace detect {
+
+namespace {
+// Histogram layout: hue x (saturation, value) level for colored pixels,
+// then brightness bins for grey ones
+constexpr int hue_bins = 18;
+constexpr double hue_bin_width = 10.0; // OpenCV hue runs 0-180
+constexpr int chroma_levels = 4;       // Low/high saturation x value
+constexpr int chroma_bins = hue_bins * chroma_levels;
+constexpr int gray_bins = 8;
+constexpr int histogram_bins = chroma_bins + gray_bins;
+constexpr int high_level = 128; // Saturation or value counted as "high"
+
+// Frame regions sampled, as fractions of the card (x0, y0, x1, y1). The
+// title bar stops before the mana cost; the side strips run between the
+// black border and the art or text box.
+constexpr std::array<std::array<double, 4>, 4> frame_regions{{
+    {0.06, 0.04, 0.60, 0.09},     // Title bar
+    {0.06, 0.565, 0.70, 0.60},    // Type line bar
+    {0.045, 0.12, 0.075, 0.88},   // Left frame strip
+    {0.925, 0.12, 0.955, 0.88}}}; // Right frame strip
+
+// Typical frame color of each class (OpenCV HSV), in FrameColor order.
+// The black title text is mixed into every signature.
+struct Prototype {
+  int hue;
+  int saturation;
+  int value;
+};
+constexpr std::array<Prototype, frame_color_count> prototypes{{
+    {25, 25, 215},   // White: pale cream
+    {105, 170, 185}, // Blue
+    {0, 15, 55},     // Black: dark grey
+    {2, 175, 180},   // Red
+    {65, 150, 120},  // Green
+    {22, 150, 205},  // Multicolor: gold
+    {105, 35, 165},  // Artifact: grey-blue
+    {15, 85, 140}}}; // Land: brown
+constexpr Prototype text_ink{0, 0, 30};
+constexpr float text_ink_weight = 0.1F;
+// Spread of the synthetic pixels around each prototype
+constexpr int hue_jitter = 4;
+constexpr int level_jitter = 25;
+
+void addPixel(float *histogram, int hue, int saturation, int value,
+              float weight, const FrameColorConfig &config) {
+  if (saturation < config.minChromaSaturation ||
+      value < config.minChromaValue) {
+    histogram[chroma_bins + value * gray_bins / 256] += weight;
+    return;
+  }
+  int level =
+      (saturation >= high_level ? 2 : 0) + (value >= high_level ? 1 : 0);
+  // Split each pixel between the two nearest hue bins, around the circle,
+  // so reds just below and above 0 land in the same bins
+  double position = hue / hue_bin_width - 0.5;
+  double lower = std::floor(position);
+  auto fraction = static_cast<float>(position - lower);
+  int first = (static_cast<int>(lower) + hue_bins) % hue_bins;
+  int second = (first + 1) % hue_bins;
+  histogram[first * chroma_levels + level] += weight * (1.0F - fraction);
+  histogram[second * chroma_levels + level] += weight * fraction;
+}
+
+void addJittered(float *histogram, const Prototype &color, float weight,
+                 const FrameColorConfig &config) {
+  constexpr int samples = 27; // Three steps on each axis
+  for (int dh = -1; dh <= 1; ++dh) {
+    for (int ds = -1; ds <= 1; ++ds) {
+      for (int dv = -1; dv <= 1; ++dv) {
+        int hue = (color.hue + dh * hue_jitter + 180) % 180;
+        int saturation =
+            std::clamp(color.saturation + ds * level_jitter, 0, 255);
+        int value = std::clamp(color.value + dv * level_jitter, 0, 255);
+        addPixel(histogram, hue, saturation, value, weight / samples,
+                 config);
+      }
+    }
+  }
+}
+
+cv::Mat prototypeSignature(const Prototype &color,
+                           const FrameColorConfig &config) {
+  cv::Mat signature(1, histogram_bins, CV_32F, cv::Scalar(0));
+  auto *bins = signature.ptr<float>();
+  addJittered(bins, color, 1.0F - text_ink_weight, config);
+  addJittered(bins, text_ink, text_ink_weight, config);
+  return signature;
+}
+
+cv::Mat frameMask() {
+  cv::Mat mask(FrameColorClassifier::thumbnailHeight,
+               FrameColorClassifier::thumbnailWidth, CV_8UC1, cv::Scalar(0));
+  for (const auto &[x0, y0, x1, y1] : frame_regions) {
+    cv::Point top_left(static_cast<int>(std::lround(x0 * mask.cols)),
+                       static_cast<int>(std::lround(y0 * mask.rows)));
+    cv::Point bottom_right(static_cast<int>(std::lround(x1 * mask.cols)),
+                           static_cast<int>(std::lround(y1 * mask.rows)));
+    // At least one pixel wide, however narrow the strip
+    bottom_right.x = std::max(bottom_right.x, top_left.x + 1);
+    bottom_right.y = std::max(bottom_right.y, top_left.y + 1);
+    mask(cv::Rect(top_left, bottom_right)).setTo(255);
+  }
+  return mask;
+}
+} // namespace
+
+std::string_view frameColorName(FrameColor color) {
+  switch (color) {
+  case FrameColor::white:
+    return "white";
+  case FrameColor::blue:
+    return "blue";
+  case FrameColor::black:
+    return "black";
+  case FrameColor::red:
+    return "red";
+  case FrameColor::green:
+    return "green";
+  case FrameColor::multicolor:
+    return "multicolor";
+  case FrameColor::artifact:
+    return "artifact";
+  case FrameColor::land:
+    return "land";
+  }
+  return "unknown";
+}
+
+std::optional<FrameColor> parseFrameColor(std::string_view name) {
+  for (std::size_t i = 0; i < frame_color_count; ++i) {
+    auto color = static_cast<FrameColor>(i);
+    if (frameColorName(color) == name) {
+      return color;
+    }
+  }
+  return std::nullopt;
+}
+
+FrameColorClassifier::FrameColorClassifier(FrameColorConfig config)
+    : config_(config), mask_(frameMask()) {
+  for (std::size_t i = 0; i < frame_color_count; ++i) {
+    signatures_[i] = prototypeSignature(prototypes[i], config_);
+  }
+}
+
+cv::Mat FrameColorClassifier::histogram(const cv::Mat &warpedCard) const {
+  ASSERT(!warpedCard.empty(), "Card image is empty");
+  ASSERT(warpedCard.channels() == 3, "Frame color needs a BGR image");
+  cv::Mat thumbnail;
+  cv::resize(warpedCard, thumbnail, mask_.size(), 0, 0, cv::INTER_AREA);
+  cv::Mat hsv;
+  cv::cvtColor(thumbnail, hsv, cv::COLOR_BGR2HSV);
+
+  cv::Mat result(1, histogram_bins, CV_32F, cv::Scalar(0));
+  auto *bins = result.ptr<float>();
+  for (int y = 0; y < hsv.rows; ++y) {
+    const auto *pixel = hsv.ptr<cv::Vec3b>(y);
+    const auto *inside = mask_.ptr<uchar>(y);
+    for (int x = 0; x < hsv.cols; ++x) {
+      if (inside[x] != 0) {
+        addPixel(bins, pixel[x][0], pixel[x][1], pixel[x][2], 1.0F, config_);
+      }
+    }
+  }
+  cv::normalize(result, result, 1.0, 0.0, cv::NORM_L1);
+  return result;
+}
+
+FrameColorDecision
+FrameColorClassifier::classify(const cv::Mat &warpedCard) const {
+  cv::Mat card = histogram(warpedCard);
+
+  std::array<double, frame_color_count> distances{};
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (std::size_t i = 0; i < frame_color_count; ++i) {
+      distances[i] =
+          cv::compareHist(card, signatures_[i], cv::HISTCMP_BHATTACHARYYA);
+    }
+  }
+
+  auto best = std::min_element(distances.begin(), distances.end());
+  double runner_up = 1.0;
+  for (auto it = distances.begin(); it != distances.end(); ++it) {
+    if (it != best) {
+      runner_up = std::min(runner_up, *it);
+    }
+  }
+
+  FrameColorDecision decision;
+  decision.color = static_cast<FrameColor>(best - distances.begin());
+  decision.similarity = 1.0 - *best;
+  if (runner_up > 0.0) {
+    decision.confidence = std::clamp((runner_up - *best) / runner_up, 0.0, 1.0);
+  }
+  return decision;
+}
+
+void FrameColorClassifier::learn(const cv::Mat &warpedCard, FrameColor color) {
+  cv::Mat card = histogram(warpedCard);
+  auto index = static_cast<std::size_t>(color);
+  ASSERT(index < frame_color_count, "Unknown frame color");
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  cv::addWeighted(signatures_[index], 1.0 - config_.learningRate, card,
+                  config_.learningRate, 0.0, signatures_[index]);
+  ++learned_;
+}
+
+std::size_t FrameColorClassifier::learnedCount() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return learned_;
+}
+
+} // namespace detect
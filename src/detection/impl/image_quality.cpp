@@ -0,0 +1,62 @@
+#include <image_quality.hpp>
+#include <libassert/assert.hpp>
+
+#include <algorithm>
+
+namespace detect {
+
+namespace {
+cv::Mat toGray(const cv::Mat &image) {
+  if (image.channels() == 1) {
+    return image;
+  }
+  cv::Mat gray;
+  cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+  return gray;
+}
+} // namespace
+
+double clippedRatio(const cv::Mat &image, int clipLevel) {
+  ASSERT(!image.empty(), "Image is empty");
+  cv::Mat gray = toGray(image);
+  int clipped = cv::countNonZero(gray >= clipLevel);
+  return static_cast<double>(clipped) / static_cast<double>(gray.total());
+}
+
+QualityScores assessQuality(const cv::Mat &card,
+                            const std::vector<cv::Rect> &regions,
+                            const QualityConfig &config) {
+  ASSERT(!card.empty(), "Card image is empty");
+  cv::Mat gray = toGray(card);
+  const cv::Rect bounds(0, 0, gray.cols, gray.rows);
+
+  QualityScores scores;
+  double sum = 0.0;
+  double sum_squares = 0.0;
+  double pixels = 0.0;
+  for (const auto &region : regions) {
+    cv::Rect roi = region & bounds;
+    if (roi.empty()) {
+      continue;
+    }
+
+    cv::Mat laplacian;
+    cv::Laplacian(gray(roi), laplacian, CV_64F);
+    sum += cv::sum(laplacian)[0];
+    sum_squares += laplacian.dot(laplacian);
+    pixels += static_cast<double>(roi.area());
+
+    scores.clippedRatio = std::max(scores.clippedRatio,
+                                   clippedRatio(gray(roi), config.clipLevel));
+  }
+
+  if (pixels > 0.0) {
+    double mean = sum / pixels;
+    scores.focus = sum_squares / pixels - mean * mean;
+  }
+  scores.sharp = scores.focus >= config.minFocus;
+  scores.exposed = scores.clippedRatio <= config.maxClippedRatio;
+  return scores;
+}
+
+} // namespace detect
@@ -0,0 +1,166 @@
+#include <ocr_profile.hpp>
+#include <path_helper.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace detect {
+
+namespace {
+constexpr int psm_single_word = 8;
+
+OcrFilter parseFilter(const std::string &value) {
+  if (value == "none") {
+    return OcrFilter::none;
+  }
+  if (value == "median") {
+    return OcrFilter::median;
+  }
+  if (value == "bilateral") {
+    return OcrFilter::bilateral;
+  }
+  throw std::runtime_error("Unknown OCR filter: " + value);
+}
+
+OcrInterpolation parseInterpolation(const std::string &value) {
+  if (value == "linear") {
+    return OcrInterpolation::linear;
+  }
+  if (value == "cubic") {
+    return OcrInterpolation::cubic;
+  }
+  if (value == "lanczos") {
+    return OcrInterpolation::lanczos;
+  }
+  throw std::runtime_error("Unknown OCR interpolation: " + value);
+}
+
+OcrPreprocessing parsePreprocessing(const std::string &value) {
+  if (value == "native") {
+    return OcrPreprocessing::native;
+  }
+  if (value == "legacy") {
+    return OcrPreprocessing::legacy;
+  }
+  throw std::runtime_error("Unknown OCR preprocessing: " + value);
+}
+
+// Overrides the settings the JSON object names; a misspelled key is an
+// error rather than a silently ignored setting
+void applySettings(const nlohmann::json &json, FieldOcrSettings &settings) {
+  for (const auto &[key, value] : json.items()) {
+    if (key == "model") {
+      settings.model = value.get<std::string>();
+    } else if (key == "language") {
+      settings.language = value.get<std::string>();
+    } else if (key == "oem") {
+      settings.engineMode = value.get<int>();
+    } else if (key == "psm") {
+      settings.pageSegMode = value.get<int>();
+    } else if (key == "whitelist") {
+      settings.whitelist = value.get<std::string>();
+    } else if (key == "scale") {
+      settings.scale = value.get<double>();
+    } else if (key == "interpolation") {
+      settings.interpolation = parseInterpolation(value.get<std::string>());
+    } else if (key == "filter") {
+      settings.filter = parseFilter(value.get<std::string>());
+    } else if (key == "preprocessing") {
+      settings.preprocessing = parsePreprocessing(value.get<std::string>());
+    } else {
+      throw std::runtime_error("Unknown OCR setting: " + key);
+    }
+  }
+  if (settings.scale <= 0.0) {
+    throw std::runtime_error("OCR scale must be positive");
+  }
+}
+} // namespace
+
+FieldOcrSettings defaultCardNameSettings() {
+  FieldOcrSettings settings;
+  settings.whitelist =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 '-,.";
+  return settings;
+}
+
+FieldOcrSettings defaultCollectorNumberSettings() {
+  FieldOcrSettings settings;
+  settings.whitelist = "0123456789";
+  settings.scale = 4.0; // Digits are large enough at 4x
+  return settings;
+}
+
+FieldOcrSettings defaultSetCodeSettings() {
+  FieldOcrSettings settings;
+  settings.pageSegMode = psm_single_word;
+  settings.whitelist = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  settings.scale = 5.0; // The set code is the smallest text
+  settings.interpolation = OcrInterpolation::lanczos;
+  return settings;
+}
+
+std::string OcrProfile::combinedKeyConflict() const {
+  const auto &digits = collectorNumber;
+  if (digits.model != setCode.model) {
+    return "model";
+  }
+  if (digits.language != setCode.language) {
+    return "language";
+  }
+  if (digits.engineMode != setCode.engineMode) {
+    return "oem";
+  }
+  if (digits.filter != setCode.filter) {
+    return "filter";
+  }
+  if (digits.preprocessing != setCode.preprocessing) {
+    return "preprocessing";
+  }
+  return {};
+}
+
+OcrProfile OcrProfile::load(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot read OCR profile: " + path.string());
+  }
+
+  OcrProfile profile;
+  profile.name = path.stem().string();
+  try {
+    auto json = nlohmann::json::parse(file);
+    if (json.contains("name")) {
+      profile.name = json["name"].get<std::string>();
+    }
+    if (json.contains("fields")) {
+      for (const auto &[field, settings] : json["fields"].items()) {
+        if (field == "name") {
+          applySettings(settings, profile.cardName);
+        } else if (field == "collector_number") {
+          applySettings(settings, profile.collectorNumber);
+        } else if (field == "set_code") {
+          applySettings(settings, profile.setCode);
+        } else {
+          throw std::runtime_error("Unknown OCR field: " + field);
+        }
+      }
+    }
+  } catch (const nlohmann::json::exception &e) {
+    throw std::runtime_error("Invalid OCR profile " + path.string() + ": " +
+                             e.what());
+  }
+  return profile;
+}
+
+std::filesystem::path ocrProfilePath(const std::string &nameOrPath) {
+  std::filesystem::path path(nameOrPath);
+  if (path.has_parent_path() || path.has_extension()) {
+    return path;
+  }
+  return misc::getDataPath() / "ocr_profiles" / (nameOrPath + ".json");
+}
+
+} // namespace detect
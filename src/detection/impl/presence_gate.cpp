@@ -0,0 +1,102 @@
+#include <libassert/assert.hpp>
+#include <presence_gate.hpp>
+
+#include <algorithm>
+
+namespace detect {
+
+namespace {
+constexpr int smoothing_kernel = 3; // Suppresses sensor noise on thumbnails
+} // namespace
+
+PresenceGate::PresenceGate(PresenceGateConfig config) : config_(config) {
+  ASSERT(config_.analysisWidth > 0, "Analysis width must be positive");
+  ASSERT(config_.stableFrames > 0, "Stable frame count must be positive");
+}
+
+void PresenceGate::reset() {
+  background_.release();
+  previous_.release();
+  learnedFrames_ = 0;
+  stillFrames_ = 0;
+  forwarding_ = false;
+}
+
+cv::Mat PresenceGate::thumbnail(const cv::Mat &frame) const {
+  // Shrink first so the color conversion and blur only touch a few
+  // thousand pixels
+  int height = std::max(1, frame.rows * config_.analysisWidth / frame.cols);
+  cv::Mat small;
+  cv::resize(frame, small, cv::Size(config_.analysisWidth, height), 0, 0,
+             cv::INTER_AREA);
+  if (small.channels() == 3) {
+    cv::cvtColor(small, small, cv::COLOR_BGR2GRAY);
+  }
+  cv::GaussianBlur(small, small, cv::Size(smoothing_kernel, smoothing_kernel),
+                   0);
+  return small;
+}
+
+double PresenceGate::changedRatio(const cv::Mat &a, const cv::Mat &b) const {
+  cv::Mat diff;
+  cv::absdiff(a, b, diff);
+  int changed = cv::countNonZero(diff > config_.pixelDiffThreshold);
+  return static_cast<double>(changed) / static_cast<double>(diff.total());
+}
+
+GateDecision PresenceGate::update(const cv::Mat &frame) {
+  ASSERT(!frame.empty(), "Frame is empty");
+  GateDecision decision;
+  cv::Mat current = thumbnail(frame);
+
+  // Size changed (e.g. camera reconfigured): start over
+  if (!previous_.empty() && previous_.size() != current.size()) {
+    reset();
+  }
+
+  if (!previous_.empty()) {
+    decision.motion = changedRatio(current, previous_);
+  }
+  previous_ = current;
+
+  // Assume the slot is empty while warming up
+  if (learnedFrames_ < config_.warmupFrames) {
+    if (background_.empty()) {
+      current.convertTo(background_, CV_32F);
+    } else {
+      cv::accumulateWeighted(current, background_,
+                             1.0 / (learnedFrames_ + 1));
+    }
+    ++learnedFrames_;
+    decision.state = GateState::learning;
+    return decision;
+  }
+
+  cv::Mat background_8u;
+  background_.convertTo(background_8u, CV_8U);
+  decision.presence = changedRatio(current, background_8u);
+
+  bool still = decision.motion < config_.motionRatio;
+  stillFrames_ = still ? stillFrames_ + 1 : 0;
+
+  if (!still) {
+    decision.state = GateState::moving;
+    forwarding_ = false;
+  } else if (decision.presence < config_.presenceRatio) {
+    decision.state = GateState::empty;
+    forwarding_ = false;
+    // Track slow lighting drift, but only while nothing is in the slot
+    cv::accumulateWeighted(current, background_, config_.learningRate);
+  } else if (stillFrames_ >= config_.stableFrames) {
+    decision.state = GateState::present;
+    decision.forward = true;
+    decision.arrival = !forwarding_;
+    forwarding_ = true;
+  } else {
+    // Card present but not settled yet
+    decision.state = GateState::moving;
+  }
+  return decision;
+}
+
+} // namespace detect
@@ -0,0 +1,181 @@
+#include <libassert/assert.hpp>
+#include <rarity.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace detect {
+
+namespace {
+constexpr double max_channel = 255.0;
+constexpr double hue_range = 180.0; // OpenCV hue
+
+// Printed symbol colors (OpenCV HSV), in Rarity order
+constexpr std::array<std::array<int, 3>, rarity_count> symbol_colors{{
+    {0, 0, 35},      // Common: black
+    {105, 25, 175},  // Uncommon: silver
+    {25, 140, 200},  // Rare: gold
+    {8, 210, 225}}}; // Mythic: orange-red
+
+// Hue as a point on the unit circle, pulled to the center for grey pixels
+// whose hue means nothing, plus the value
+cv::Vec3d colorPoint(double hue, double saturation, double value) {
+  double angle = 2.0 * CV_PI * hue / hue_range;
+  double chroma = saturation / max_channel;
+  return {chroma * std::cos(angle), chroma * std::sin(angle),
+          value / max_channel};
+}
+} // namespace
+
+std::string_view rarityName(Rarity rarity) {
+  switch (rarity) {
+  case Rarity::common:
+    return "common";
+  case Rarity::uncommon:
+    return "uncommon";
+  case Rarity::rare:
+    return "rare";
+  case Rarity::mythic:
+    return "mythic";
+  }
+  return "unknown";
+}
+
+std::optional<Rarity> parseRarity(std::string_view name) {
+  for (std::size_t i = 0; i < rarity_count; ++i) {
+    auto rarity = static_cast<Rarity>(i);
+    if (rarityName(rarity) == name) {
+      return rarity;
+    }
+  }
+  return std::nullopt;
+}
+
+RarityClassifier::RarityClassifier(RarityConfig config) : config_(config) {
+  for (std::size_t i = 0; i < rarity_count; ++i) {
+    const auto &[hue, saturation, value] = symbol_colors[i];
+    prototypes_[i] = colorPoint(hue, saturation, value);
+  }
+}
+
+std::optional<cv::Vec3d>
+RarityClassifier::symbolColor(const cv::Mat &symbol,
+                              double &symbolRatio) const {
+  ASSERT(!symbol.empty(), "Symbol image is empty");
+  ASSERT(symbol.channels() == 3, "Rarity needs a BGR image");
+
+  // The type line bar around the symbol is the background
+  cv::Mat ring(symbol.size(), CV_8UC1, cv::Scalar(0));
+  cv::rectangle(ring, cv::Rect(0, 0, symbol.cols, symbol.rows),
+                cv::Scalar(255), 1);
+  cv::Scalar background = cv::mean(symbol, ring);
+
+  cv::Mat contrast(symbol.size(), CV_8UC1, cv::Scalar(0));
+  for (int y = 0; y < symbol.rows; ++y) {
+    const auto *bgr = symbol.ptr<cv::Vec3b>(y);
+    auto *out = contrast.ptr<uchar>(y);
+    for (int x = 0; x < symbol.cols; ++x) {
+      double db = bgr[x][0] - background[0];
+      double dg = bgr[x][1] - background[1];
+      double dr = bgr[x][2] - background[2];
+      if (std::sqrt(db * db + dg * dg + dr * dr) >=
+          config_.minSymbolContrast) {
+        out[x] = 255;
+      }
+    }
+  }
+
+  // Silver and gold fills can be close to a light bar, but every symbol
+  // has a dark outline: the symbol is the largest outlined blob, filled.
+  // Smaller blobs are the end of a long type line.
+  std::vector<std::vector<cv::Point>> contours;
+  cv::findContours(contrast, contours, cv::RETR_EXTERNAL,
+                   cv::CHAIN_APPROX_SIMPLE);
+  if (contours.empty()) {
+    symbolRatio = 0.0;
+    return std::nullopt;
+  }
+  auto largest = std::max_element(
+      contours.begin(), contours.end(), [](const auto &a, const auto &b) {
+        return cv::contourArea(a) < cv::contourArea(b);
+      });
+  cv::Mat mask(symbol.size(), CV_8UC1, cv::Scalar(0));
+  cv::drawContours(mask, contours, static_cast<int>(largest - contours.begin()),
+                   cv::Scalar(255), cv::FILLED);
+
+  cv::Mat hsv;
+  cv::cvtColor(symbol, hsv, cv::COLOR_BGR2HSV);
+  cv::Vec3d sum;
+  int pixels = 0;
+  for (int y = 0; y < hsv.rows; ++y) {
+    const auto *color = hsv.ptr<cv::Vec3b>(y);
+    const auto *inside = mask.ptr<uchar>(y);
+    for (int x = 0; x < hsv.cols; ++x) {
+      if (inside[x] != 0) {
+        sum += colorPoint(color[x][0], color[x][1], color[x][2]);
+        ++pixels;
+      }
+    }
+  }
+
+  symbolRatio = static_cast<double>(pixels) / symbol.total();
+  if (pixels == 0 || symbolRatio < config_.minSymbolRatio) {
+    return std::nullopt;
+  }
+  return sum / pixels;
+}
+
+RarityDecision RarityClassifier::classify(const cv::Mat &symbol) const {
+  RarityDecision decision;
+  auto color = symbolColor(symbol, decision.symbolRatio);
+  if (!color) {
+    return decision;
+  }
+
+  std::array<double, rarity_count> distances{};
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (std::size_t i = 0; i < rarity_count; ++i) {
+      distances[i] = cv::norm(*color - prototypes_[i]);
+    }
+  }
+
+  auto best = std::min_element(distances.begin(), distances.end());
+  double runner_up = std::numeric_limits<double>::max();
+  for (auto it = distances.begin(); it != distances.end(); ++it) {
+    if (it != best) {
+      runner_up = std::min(runner_up, *it);
+    }
+  }
+  decision.rarity = static_cast<Rarity>(best - distances.begin());
+  if (runner_up > 0.0) {
+    decision.confidence = (runner_up - *best) / runner_up;
+  }
+  return decision;
+}
+
+bool RarityClassifier::learn(const cv::Mat &symbol, Rarity rarity) {
+  double symbol_ratio = 0.0;
+  auto color = symbolColor(symbol, symbol_ratio);
+  if (!color) {
+    return false;
+  }
+
+  auto index = static_cast<std::size_t>(rarity);
+  ASSERT(index < rarity_count, "Unknown rarity");
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  prototypes_[index] = (1.0 - config_.learningRate) * prototypes_[index] +
+                       config_.learningRate * *color;
+  ++learned_;
+  return true;
+}
+
+std::size_t RarityClassifier::learnedCount() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return learned_;
+}
+
+} // namespace detect
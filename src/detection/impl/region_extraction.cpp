@@ -1,6 +1,10 @@
 #include <region_extraction.hpp>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace detect {
 
 namespace {
@@ -26,6 +30,12 @@ constexpr double set_width_ratio = 0.12; // 12% of card width
 constexpr double set_height_ratio =
     0.035; // 3.5% of card height (larger region)
 
+// Set symbol region (modern layout - right end of the type line)
+constexpr double symbol_left_ratio = 0.84;   // 84% from left
+constexpr double symbol_top_ratio = 0.555;   // 55.5% from top
+constexpr double symbol_width_ratio = 0.11;  // 11% of card width
+constexpr double symbol_height_ratio = 0.05; // 5% of card height
+
 // Art region
 constexpr double art_left_ratio = 0.104;   // 10.4% from left
 constexpr double art_top_ratio = 0.382;    // 38.2% from top
@@ -58,6 +68,43 @@ constexpr double y_position_tolerance = 0.25;    // Tolerance for Y position
 constexpr int morph_size = 3;               // Size for morphological operations
 constexpr double min_contour_area = 1000.0; // Minimum contour area in pixels
 } // namespace art_detect
+
+// Text starts at the left of every text region; blocks to the right of it
+// (mana symbols) and specks to the left of it carry less ink
+constexpr double min_block_ink = 0.25; // Of the heaviest block's ink
+
+// Consecutive profile entries at or above a threshold
+struct InkRun {
+  int begin{0};
+  int end{0}; // Exclusive
+  long mass{0};
+};
+
+// Runs of the profile at or above the threshold; runs separated by at most
+// maxGap entries are merged
+std::vector<InkRun> inkRuns(const std::vector<int> &profile, int threshold,
+                            int maxGap) {
+  std::vector<InkRun> runs;
+  for (int i = 0; i < static_cast<int>(profile.size()); ++i) {
+    int value = profile[static_cast<std::size_t>(i)];
+    if (value < threshold) {
+      continue;
+    }
+    if (!runs.empty() && i - runs.back().end <= maxGap) {
+      runs.back().end = i + 1;
+      runs.back().mass += value;
+    } else {
+      runs.push_back({i, i + 1, value});
+    }
+  }
+  return runs;
+}
+
+std::vector<int> projection(const cv::Mat &ink, int dimension) {
+  cv::Mat sums;
+  cv::reduce(ink, sums, dimension, cv::REDUCE_SUM, CV_32S);
+  return std::vector<int>(sums.begin<int>(), sums.end<int>());
+}
 } // namespace
 
 cv::Rect extractNameRegion(const cv::Mat &image) {
@@ -87,6 +134,15 @@ cv::Rect extractSetNameRegionModern(const cv::Mat &image) {
   return {x, y, width, height};
 }
 
+cv::Rect extractSetSymbolRegionModern(const cv::Mat &image) {
+  int x = static_cast<int>(image.cols * regions::symbol_left_ratio);
+  int y = static_cast<int>(image.rows * regions::symbol_top_ratio);
+  int width = static_cast<int>(image.cols * regions::symbol_width_ratio);
+  int height = static_cast<int>(image.rows * regions::symbol_height_ratio);
+
+  return {x, y, width, height};
+}
+
 cv::Rect extractArtRegionRegular(const cv::Mat &image) {
   // Convert to grayscale
   cv::Mat gray;
@@ -149,6 +205,69 @@ cv::Rect extractArtRegionRegular(const cv::Mat &image) {
   return {};
 }
 
+cv::Rect fitTextLine(const cv::Mat &image, const cv::Rect &region,
+                     const TextLineConfig &config) {
+  cv::Rect bounds = region & cv::Rect(0, 0, image.cols, image.rows);
+  if (bounds.empty()) {
+    return region;
+  }
+
+  cv::Mat gray;
+  if (image.channels() == 3) {
+    cv::cvtColor(image(bounds), gray, cv::COLOR_BGR2GRAY);
+  } else {
+    gray = image(bounds);
+  }
+  // Ink is 1; it is the minority class, so light text on a dark bar works
+  cv::Mat ink;
+  cv::threshold(gray, ink, 0, 1, cv::THRESH_BINARY_INV | cv::THRESH_OTSU);
+  if (cv::countNonZero(ink) > bounds.area() / 2) {
+    ink = 1 - ink;
+  }
+
+  // The text line is the row band with the most ink; full-width frame lines
+  // are dropped first
+  auto rows = projection(ink, 1);
+  for (auto &row : rows) {
+    if (row > config.maxRowInk * bounds.width) {
+      row = 0;
+    }
+  }
+  auto row_threshold =
+      std::max(1, static_cast<int>(config.minRowInk * bounds.width));
+  auto bands = inkRuns(rows, row_threshold, 1);
+  auto line = std::max_element(
+      bands.begin(), bands.end(),
+      [](const InkRun &a, const InkRun &b) { return a.mass < b.mass; });
+  if (line == bands.end() ||
+      line->end - line->begin < config.minHeight * bounds.height) {
+    return region;
+  }
+  int line_height = line->end - line->begin;
+
+  // Columns of the band: word gaps stay inside the text, wider gaps end it
+  auto columns = projection(ink.rowRange(line->begin, line->end), 0);
+  auto max_gap = static_cast<int>(std::lround(config.maxWordGap * line_height));
+  auto blocks = inkRuns(columns, 1, max_gap);
+  long heaviest = 0;
+  for (const auto &block : blocks) {
+    heaviest = std::max(heaviest, block.mass);
+  }
+  auto text = std::find_if(blocks.begin(), blocks.end(),
+                           [heaviest](const InkRun &block) {
+                             return block.mass >= min_block_ink * heaviest;
+                           });
+  if (text == blocks.end()) {
+    return region;
+  }
+
+  auto pad = static_cast<int>(std::lround(config.padding * line_height));
+  cv::Rect fitted(text->begin - pad, line->begin - pad,
+                  text->end - text->begin + 2 * pad, line_height + 2 * pad);
+  fitted &= cv::Rect(0, 0, bounds.width, bounds.height);
+  return fitted + bounds.tl();
+}
+
 cv::Rect extractTextRegion(const cv::Mat &image) {
   int x = static_cast<int>(image.cols * regions::text_left_ratio);
   int y = static_cast<int>(image.rows * regions::text_top_ratio);
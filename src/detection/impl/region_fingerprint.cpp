@@ -0,0 +1,39 @@
+#include <libassert/assert.hpp>
+#include <region_fingerprint.hpp>
+
+namespace detect {
+
+namespace {
+constexpr int grid_columns = 64; // Comparisons per row
+constexpr int grid_rows = 8;     // One word per row
+constexpr int flat_margin = 8;   // Grey steps (after stretching) seen as flat
+} // namespace
+
+RegionFingerprint fingerprintRegion(const cv::Mat &region) {
+  ASSERT(!region.empty(), "Region image is empty");
+  cv::Mat gray;
+  if (region.channels() == 1) {
+    gray = region;
+  } else {
+    cv::cvtColor(region, gray, cv::COLOR_BGR2GRAY);
+  }
+
+  cv::Mat small;
+  cv::resize(gray, small, cv::Size(grid_columns + 1, grid_rows), 0, 0,
+             cv::INTER_AREA);
+  cv::normalize(small, small, 0, 255, cv::NORM_MINMAX);
+
+  RegionFingerprint fingerprint;
+  for (int y = 0; y < grid_rows; ++y) {
+    const auto *row = small.ptr<std::uint8_t>(y);
+    std::uint64_t bits = 0;
+    for (int x = 0; x < grid_columns; ++x) {
+      bits = (bits << 1) |
+             static_cast<std::uint64_t>(row[x + 1] > row[x] + flat_margin);
+    }
+    fingerprint.rows[static_cast<std::size_t>(y)] = bits;
+  }
+  return fingerprint;
+}
+
+} // namespace detect
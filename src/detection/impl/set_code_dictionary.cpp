@@ -0,0 +1,158 @@
+#include <set_code_dictionary.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace detect {
+
+namespace {
+// The reader keeps at most three letters, so longer codes cannot be read
+constexpr std::size_t max_code_length = 3;
+
+// Probability that Tesseract read the first letter for the second, or the
+// other way round, in the small bold set code font
+constexpr double lookalike_probability = 0.5;
+// Any other substitution Tesseract did not offer as an alternative
+constexpr double unrelated_probability = 0.02;
+// Letters a missing or extra character stands for
+constexpr double gap_probability = 0.05;
+
+constexpr std::array<std::pair<char, char>, 20> lookalikes = {{
+    {'O', 'D'}, {'O', 'Q'}, {'O', 'C'}, {'C', 'G'}, {'D', 'B'},
+    {'B', 'E'}, {'B', 'R'}, {'B', 'S'}, {'E', 'F'}, {'F', 'P'},
+    {'P', 'R'}, {'I', 'L'}, {'I', 'T'}, {'I', 'J'}, {'M', 'N'},
+    {'N', 'H'}, {'M', 'W'}, {'U', 'V'}, {'V', 'Y'}, {'K', 'X'},
+}};
+
+double confusion(char read, char actual) {
+  if (read == actual) {
+    return 1.0;
+  }
+  for (const auto &[a, b] : lookalikes) {
+    if ((a == read && b == actual) || (a == actual && b == read)) {
+      return lookalike_probability;
+    }
+  }
+  return unrelated_probability;
+}
+
+// Reads without alternatives count every character at the mean confidence
+std::vector<std::vector<CharChoice>> choicesOf(const OcrResult &read) {
+  if (!read.choices.empty()) {
+    return read.choices;
+  }
+  std::vector<std::vector<CharChoice>> choices;
+  for (char letter : read.text) {
+    choices.push_back({{letter, static_cast<float>(read.confidence)}});
+  }
+  return choices;
+}
+
+// Geometric mean per-character probability that the read is this code
+double score(const std::vector<std::vector<CharChoice>> &choices,
+             const std::string &code) {
+  std::size_t length = std::max(choices.size(), code.size());
+  double log_sum = 0.0;
+  for (std::size_t i = 0; i < length; ++i) {
+    double probability = gap_probability;
+    if (i < choices.size() && i < code.size()) {
+      probability = 0.0;
+      for (const auto &choice : choices[i]) {
+        double confidence = std::clamp(choice.confidence / 100.0, 0.0, 1.0);
+        probability =
+            std::max(probability, confidence * confusion(choice.letter,
+                                                          code[i]));
+      }
+      probability = std::max(probability, unrelated_probability *
+                                              unrelated_probability);
+    }
+    log_sum += std::log(probability);
+  }
+  return std::exp(log_sum / static_cast<double>(length));
+}
+} // namespace
+
+SetCodeDictionary::SetCodeDictionary(std::vector<std::string> codes,
+                                     SetCodeMatchConfig config)
+    : codes_(std::move(codes)), config_(config) {
+  std::sort(codes_.begin(), codes_.end());
+  codes_.erase(std::unique(codes_.begin(), codes_.end()), codes_.end());
+}
+
+bool SetCodeDictionary::contains(const std::string &code) const {
+  return std::binary_search(codes_.begin(), codes_.end(), code);
+}
+
+OcrResult SetCodeDictionary::correct(const OcrResult &read) const {
+  auto choices = choicesOf(read);
+  if (choices.empty() || codes_.empty()) {
+    return {};
+  }
+
+  const std::string *best = nullptr;
+  double best_score = 0.0;
+  double runner_up = 0.0;
+  for (const auto &code : codes_) {
+    double candidate = score(choices, code);
+    if (candidate > best_score) {
+      runner_up = best_score;
+      best_score = candidate;
+      best = &code;
+    } else {
+      runner_up = std::max(runner_up, candidate);
+    }
+  }
+
+  if (best == nullptr || best_score < config_.minScore ||
+      best_score < runner_up * config_.minLead) {
+    spdlog::debug("Set code '{}' matches no known set (best {:.2f})",
+                  read.text, best_score);
+    return {};
+  }
+  if (*best != read.text) {
+    spdlog::debug("Set code '{}' corrected to {} ({:.2f})", read.text, *best,
+                  best_score);
+  }
+  return {*best, static_cast<int>(std::lround(best_score * 100.0))};
+}
+
+SetCodeDictionary SetCodeDictionary::load(const std::filesystem::path &path,
+                                          SetCodeMatchConfig config) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot read set codes: " + path.string());
+  }
+
+  std::vector<std::string> codes;
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::string code;
+    for (char c : line) {
+      if (std::isspace(static_cast<unsigned char>(c)) == 0) {
+        code += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      }
+    }
+    bool readable =
+        !code.empty() && code.size() <= max_code_length &&
+        std::all_of(code.begin(), code.end(),
+                    [](char c) { return c >= 'A' && c <= 'Z'; });
+    if (readable) {
+      codes.push_back(std::move(code));
+    }
+  }
+
+  if (codes.empty()) {
+    throw std::runtime_error("No readable set codes in " + path.string());
+  }
+  return SetCodeDictionary(std::move(codes), config);
+}
+
+} // namespace detect
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace detect {
+
+// 128-bit perceptual hash of a card's art: a 64-bit gradient hash (dHash)
+// and a 64-bit DCT hash (pHash). dHash is cheap and robust to exposure;
+// pHash is robust to blur and small shifts. Both are summed into one
+// Hamming distance.
+struct ArtHash {
+  std::uint64_t dHash{0};
+  std::uint64_t pHash{0};
+
+  bool operator==(const ArtHash &other) const {
+    return dHash == other.dHash && pHash == other.pHash;
+  }
+  bool operator!=(const ArtHash &other) const { return !(*this == other); }
+};
+
+// Number of differing bits (0-128). Compiles to the hardware popcount
+// instruction where the target has one.
+[[nodiscard]] inline int hammingDistance(const ArtHash &a, const ArtHash &b) {
+  return __builtin_popcountll(a.dHash ^ b.dHash) +
+         __builtin_popcountll(a.pHash ^ b.pHash);
+}
+
+// Part of a normalized, upright card that is art in every regular frame.
+// Deliberately inset from the art box so small warp errors do not pull
+// frame or text into the hash.
+[[nodiscard]] cv::Rect artHashRegion(const cv::Mat &card);
+
+// Hash an art crop (BGR or grey, any size)
+[[nodiscard]] ArtHash computeArtHash(const cv::Mat &art);
+
+// 32 hex digits, dHash first
+[[nodiscard]] std::string toHex(const ArtHash &hash);
+// Throws std::invalid_argument on anything but 32 hex digits
+[[nodiscard]] ArtHash artHashFromHex(const std::string &hex);
+
+} // namespace detect
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <art_hash.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace detect {
+
+struct ArtMatch {
+  std::string id; // Scryfall ID of the reference printing
+  int distance{0};
+};
+
+// Art hashes of reference printings, searchable by Hamming distance. Stored
+// as a BK-tree: the triangle inequality lets a query skip every subtree
+// whose edge distance is further than maxDistance from the query's own
+// distance, so a lookup touches a small part of the index.
+class ArtIndex {
+public:
+  void add(std::string id, const ArtHash &hash);
+
+  // All printings within maxDistance, nearest first
+  [[nodiscard]] std::vector<ArtMatch> query(const ArtHash &hash,
+                                            int maxDistance) const;
+
+  [[nodiscard]] std::size_t size() const { return nodes_.size(); }
+  [[nodiscard]] bool empty() const { return nodes_.empty(); }
+
+  // Text file with one "<scryfall id> <hash hex>" line per printing.
+  // load() throws std::runtime_error on unreadable or malformed files.
+  void save(const std::filesystem::path &path) const;
+  [[nodiscard]] static ArtIndex load(const std::filesystem::path &path);
+
+private:
+  struct Node {
+    ArtHash hash;
+    std::string id;
+    std::vector<std::pair<int, std::size_t>> children; // Distance, node
+  };
+
+  std::vector<Node> nodes_; // Root first, in insertion order
+};
+
+} // namespace detect
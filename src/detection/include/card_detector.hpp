@@ -6,14 +6,47 @@
 
 namespace detect {
 
-// Process a card from an image file - this is the only public interface
+// Process a card from an image file
 [[nodiscard]] cv::Mat processCards(const std::filesystem::path &imagePath);
 
+// Process a card from an already loaded frame (e.g. from a camera)
+[[nodiscard]] cv::Mat processFrame(const cv::Mat &frame);
+
+// A card found in a multi-card frame
+struct DetectedCard {
+  cv::Mat image;                    // Warped to the normalized card size
+  std::vector<cv::Point2f> corners; // TL, TR, BR, BL in the frame
+};
+
+// Find and warp every card in the frame (e.g. a binder page), in reading
+// order. Returns an empty vector if there is none.
+[[nodiscard]] std::vector<DetectedCard> processAllCards(const cv::Mat &frame);
+
 namespace detail {
 // Internal helper functions
 [[nodiscard]] bool loadImage(const std::filesystem::path &imagePath,
                              cv::Mat &originalImage, cv::Mat &undistortedImage);
 void undistortImage(cv::Mat &undistortedImage);
+// Card-shaped contours larger than minAreaRatio * min(w, h)^2; only the
+// outermost ones unless nested is set
+[[nodiscard]] std::vector<std::vector<cv::Point>>
+findCardContours(const cv::Mat &undistortedImage, double minAreaRatio,
+                 bool nested = false);
+// Drop contours that enclose smaller cards (a page or sleeve outline) and
+// contours inside a card that are the inner edge of its own border
+void removeNestedContours(std::vector<std::vector<cv::Point>> &contours);
+// Quad of a card contour; corners are TL, TR, BR, BL
+[[nodiscard]] std::vector<cv::Point2f>
+contourCorners(const std::vector<cv::Point> &contour);
+// Full-image contour search for the largest card
+[[nodiscard]] bool findCardCorners(const cv::Mat &undistortedImage,
+                                   std::vector<cv::Point2f> &corners);
+// Full-image contour search for all cards, in reading order
+[[nodiscard]] bool
+findAllCardCorners(const cv::Mat &undistortedImage,
+                   std::vector<std::vector<cv::Point2f>> &cards);
+// Sort card quads into rows (top to bottom), each left to right
+void sortReadingOrder(std::vector<std::vector<cv::Point2f>> &cards);
 [[nodiscard]] bool detectCards(const cv::Mat &undistortedImage,
                                std::vector<cv::Mat> &processed_cards);
 [[nodiscard]] cv::Mat warpCard(const std::vector<cv::Point2f> &corners,
@@ -24,6 +57,10 @@ sortCorners(const std::vector<cv::Point2f> &corners);
 // Normalized card dimensions
 constexpr int normalizedWidth = 480;
 constexpr int normalizedHeight = 680;
+
+// Width / height of a card quad, shared by full detection and the tracker
+constexpr double cardAspectRatio = 0.714; // Standard MTG card ratio (2.5/3.5)
+constexpr double aspectRatioTolerance = 0.2;
 } // namespace detail
 
 } // namespace detect
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+namespace detect {
+
+enum class CardFace {
+  front,   // Readable card face
+  back,    // Card lies face down
+  notACard // Detected quad is blank (tray, paper, sleeve insert)
+};
+
+// Thresholds for the card-back / non-card check
+struct FaceConfig {
+  // Card-back frame: brown border (OpenCV hue 0-180)
+  int backBorderMinHue{5};
+  int backBorderMaxHue{25};
+  int backBorderMinSaturation{80};
+  int backBorderMinValue{50};
+  // Card-back center: blue oval
+  int backCenterMinHue{95};
+  int backCenterMaxHue{135};
+  double backCenterMinBlueRatio{0.3};
+  // Template correlation (only with a template)
+  double backMinCorrelation{0.7};
+  // Anything flatter than this is not a card
+  double minCardStddev{8.0};
+};
+
+struct FaceDecision {
+  CardFace face{CardFace::front};
+  double correlation{0.0}; // Against the card-back template (0 if none)
+  double stddev{0.0};      // Grey-level spread of the thumbnail
+};
+
+// Classifies a warped card on a tiny thumbnail so face-down cards and blank
+// quads are rejected before any OCR or network traffic. With a card-back
+// template the decision uses normalized cross-correlation; without one it
+// falls back to the back's color signature (brown border, blue center).
+class CardFaceClassifier {
+public:
+  explicit CardFaceClassifier(FaceConfig config = {});
+
+  // Photo or scan of a card back, any size
+  void setBackTemplate(const cv::Mat &cardBack);
+  [[nodiscard]] bool hasBackTemplate() const { return !backTemplate_.empty(); }
+
+  [[nodiscard]] FaceDecision classify(const cv::Mat &warpedCard) const;
+
+  // Thumbnail size used for all comparisons
+  static constexpr int thumbnailWidth = 34;
+  static constexpr int thumbnailHeight = 48;
+
+private:
+  [[nodiscard]] bool hasBackColors(const cv::Mat &thumbnail) const;
+
+  FaceConfig config_;
+  cv::Mat backTemplate_; // Grey thumbnail of the card back
+};
+
+} // namespace detect
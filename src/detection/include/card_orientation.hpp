@@ -0,0 +1,33 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+namespace detect {
+
+// Bands and thresholds for the upside-down check. The top band covers the
+// name bar; the bottom band is its 180° mirror, the info strip.
+struct OrientationConfig {
+  double bandTop{0.033};    // Name bar top, fraction of card height
+  double bandHeight{0.065}; // Name bar height, fraction of card height
+  double bandInset{0.04};   // Horizontal inset, fraction of card width
+  double minBrightnessGap{20.0}; // Grey levels between the two bands
+  double minInkGap{0.02};        // Difference in text pixel fraction
+  int inkContrast{40}; // Distance from the band mean counted as text
+};
+
+struct OrientationScores {
+  double topBrightness{0.0};    // Mean grey level of the top band
+  double bottomBrightness{0.0}; // Mean grey level of the bottom band
+  double topInk{0.0};           // Fraction of text pixels in the top band
+  double bottomInk{0.0};        // Fraction of text pixels in the bottom band
+  bool upsideDown{false};
+};
+
+// Decide whether a warped card lies upside down. Upright, the top band holds
+// the light name bar with large text and the bottom band the dark info strip
+// with small text. Both signals must point the other way before the card is
+// called upside down; anything ambiguous is left as warped.
+[[nodiscard]] OrientationScores
+assessOrientation(const cv::Mat &card, const OrientationConfig &config = {});
+
+} // namespace detect
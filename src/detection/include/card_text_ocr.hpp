@@ -1,10 +1,64 @@
 #pragma once
 
+#include <ocr_profile.hpp>
+
 #include <opencv2/opencv.hpp>
 #include <string>
+#include <vector>
 
 namespace detect {
 
+// One character Tesseract considered at a position
+struct CharChoice {
+  char letter{0};
+  float confidence{0.0F}; // 0-100
+};
+
+// Recognized text with Tesseract's mean word confidence (0-100)
+struct OcrResult {
+  std::string text;
+  int confidence{0};
+  // Alternatives for each recognized character, best first. Only the set
+  // code reader asks Tesseract for them.
+  std::vector<std::vector<CharChoice>> choices;
+};
+
+// Recognize text in a card region, keeping the confidence
+[[nodiscard]] OcrResult recognizeText(const cv::Mat &image,
+                                      const FieldOcrSettings &settings);
+[[nodiscard]] OcrResult
+recognizeCollectorNumber(const cv::Mat &image,
+                         const FieldOcrSettings &settings);
+[[nodiscard]] OcrResult recognizeSetCode(const cv::Mat &image,
+                                         const FieldOcrSettings &settings);
+
+// Same, with the field's default settings in another language
+[[nodiscard]] OcrResult recognizeText(const cv::Mat &image,
+                                      const std::string &language = "eng");
+[[nodiscard]] OcrResult
+recognizeCollectorNumber(const cv::Mat &image,
+                         const std::string &language = "eng");
+[[nodiscard]] OcrResult recognizeSetCode(const cv::Mat &image,
+                                         const std::string &language = "eng");
+
+// Collector number and set code, the key of the Scryfall lookup
+struct LookupKeyResult {
+  OcrResult collectorNumber;
+  OcrResult setCode;
+};
+
+// Read both key fields from the bottom-left info block in one pass: the
+// strip is preprocessed once and one engine recognizes each box (relative
+// to the strip) as a rectangle of the same image. Model and preprocessing
+// are the set code's; each field keeps its own whitelist and segmentation.
+[[nodiscard]] LookupKeyResult
+recognizeLookupKey(const cv::Mat &strip, const cv::Rect &collectorBox,
+                   const cv::Rect &setBox, const OcrProfile &profile);
+[[nodiscard]] LookupKeyResult
+recognizeLookupKey(const cv::Mat &strip, const cv::Rect &collectorBox,
+                   const cv::Rect &setBox,
+                   const std::string &language = "eng");
+
 // Extract text from a card region using OCR
 [[nodiscard]] std::string extractText(const cv::Mat &image,
                                       const std::string &language = "eng");
@@ -18,7 +72,14 @@ extractCollectorNumber(const cv::Mat &image,
 [[nodiscard]] std::string extractSetCode(const cv::Mat &image,
                                          const std::string &language = "eng");
 
+// Digits of a read collector number as Scryfall lists them: the last three,
+// without leading zeros
+[[nodiscard]] std::string normalizeCollectorNumber(const std::string &raw);
+
+
 // Preprocess image for better OCR results
-[[nodiscard]] cv::Mat preprocessForOcr(const cv::Mat &image);
+[[nodiscard]] cv::Mat
+preprocessForOcr(const cv::Mat &image,
+                 const FieldOcrSettings &settings = defaultCardNameSettings());
 
 } // namespace detect
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+namespace detect {
+
+// Tuning for frame-to-frame card tracking
+struct TrackerConfig {
+  double roiMargin{0.25};      // Search margin around the last quad (of size)
+  double maxFlowError{1.5};    // Forward-backward corner error in pixels
+  double maxPatchError{20.0};  // Mean grey difference of a corner patch
+  double maxAreaChange{0.08};  // Relative quad area change per frame
+  int refreshInterval{30};     // Frames between ROI re-detections (drift)
+  int flowWindow{21};          // Lucas-Kanade window size
+  int flowLevels{2};           // Lucas-Kanade pyramid levels
+};
+
+enum class TrackSource {
+  none, // No card found
+  flow, // Corners followed by optical flow
+  roi,  // Contour search around the last corners
+  full  // Contour search over the whole frame
+};
+
+struct TrackResult {
+  TrackSource source{TrackSource::none};
+  std::vector<cv::Point2f> corners; // TL, TR, BR, BL in frame coordinates
+  cv::Mat card;                     // Warped card (empty if none found)
+
+  [[nodiscard]] bool found() const { return source != TrackSource::none; }
+};
+
+// Follows a card across video frames. Once a quad is known, its corners are
+// followed with pyramidal Lucas-Kanade inside a small ROI; if the flow is
+// inconsistent the contour search runs on the ROI, and only if that fails on
+// the whole frame.
+class CardTracker {
+public:
+  explicit CardTracker(TrackerConfig config = {});
+
+  // Locate and warp the card in a BGR frame
+  [[nodiscard]] TrackResult track(const cv::Mat &frame);
+
+  // Drop the current track (e.g. when a new card arrives)
+  void reset();
+
+  [[nodiscard]] bool isTracking() const { return !corners_.empty(); }
+  [[nodiscard]] const TrackerConfig &config() const { return config_; }
+
+private:
+  [[nodiscard]] cv::Rect searchRegion(cv::Size frameSize) const;
+  [[nodiscard]] bool followCorners(const cv::Mat &frame,
+                                   std::vector<cv::Point2f> &corners) const;
+  [[nodiscard]] bool detectInRegion(const cv::Mat &frame,
+                                    std::vector<cv::Point2f> &corners) const;
+  [[nodiscard]] bool isPlausible(const std::vector<cv::Point2f> &corners) const;
+  void remember(const cv::Mat &frame, const std::vector<cv::Point2f> &corners);
+
+  TrackerConfig config_;
+  std::vector<cv::Point2f> corners_; // Corners in the previous frame
+  cv::Rect region_;                  // Search region around corners_
+  cv::Mat previousGray_;             // Grey crop of region_ in the last frame
+  int framesSinceRefresh_{0};
+};
+
+} // namespace detect
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <card_text_ocr.hpp>
+
+#include <opencv2/opencv.hpp>
+
+#include <array>
+#include <cstddef>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace detect {
+
+struct DigitRecognizerConfig {
+  double minGlyphHeight{0.35}; // Fraction of the strip height
+  double rejectScore{0.45}; // Glyphs matching no digit this well are not
+                            // digits (rarity letter, slash)
+  double minMargin{0.08};   // Best digit must beat the next best by this
+  double minNumberGap{0.5}; // Gap (fraction of glyph height) that sets a
+                            // letter apart from the number
+  std::size_t maxLearnedPerDigit{8}; // Oldest learned glyph is replaced
+};
+
+// Reads collector numbers without Tesseract. The thresholded strip is cut
+// into glyphs by connected components, and each glyph is matched against
+// normalized digit bitmaps by correlation. The bitmaps start as rendered
+// digits and are joined by glyphs of cards the lookup confirmed, so the
+// printed font is learned as the scanner runs. Safe to share between
+// workflows on different threads.
+class DigitRecognizer {
+public:
+  explicit DigitRecognizer(DigitRecognizerConfig config = {});
+
+  // Collector number normalized like the Tesseract reader; it ends at a
+  // slash or at a letter set apart by a gap. The confidence (0-100) is the
+  // worst glyph's correlation, or 0 if any glyph is ambiguous, a glyph
+  // within the number matches no digit, or the strip holds no digits.
+  [[nodiscard]] OcrResult recognize(const cv::Mat &strip) const;
+
+  // Add the glyphs of a confirmed collector number as templates. False if
+  // the digit glyphs in the strip cannot be lined up with it.
+  bool learn(const cv::Mat &strip, const std::string &collectorNumber);
+
+  [[nodiscard]] std::size_t learnedCount() const;
+
+private:
+  struct Match {
+    int digit{-1};
+    double score{-1.0};
+    double margin{0.0};
+    double slash{-1.0}; // Best correlation with a rendered slash
+  };
+
+  [[nodiscard]] Match classify(const cv::Mat &glyph) const;
+
+  DigitRecognizerConfig config_;
+  mutable std::shared_mutex mutex_; // Guards learned_ and nextLearned_
+  std::array<std::vector<cv::Mat>, 10> rendered_; // Per digit, fixed
+  std::array<std::vector<cv::Mat>, 10> learned_;  // Per digit, bounded
+  std::vector<cv::Mat> slashes_; // Ends the number; the card total follows
+  std::array<std::size_t, 10> nextLearned_{};     // Slot replaced next
+};
+
+} // namespace detect
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+
+namespace detect {
+
+// Color class of a card as its frame shows it
+enum class FrameColor {
+  white,
+  blue,
+  black,
+  red,
+  green,
+  multicolor, // Gold frame
+  artifact,   // Grey-blue frame of colorless artifacts
+  land        // Brown frame of nonbasic lands
+};
+
+inline constexpr std::size_t frame_color_count = 8;
+
+// Lowercase name ("white", "multicolor", ...) for logs and reports
+[[nodiscard]] std::string_view frameColorName(FrameColor color);
+
+// Inverse of frameColorName; empty for an unknown name
+[[nodiscard]] std::optional<FrameColor> parseFrameColor(std::string_view name);
+
+struct FrameColorConfig {
+  // Pixels below either level are binned by brightness only; their hue is
+  // noise (white, black and artifact frames)
+  int minChromaSaturation{50};
+  int minChromaValue{50};
+  double learningRate{0.1}; // Weight of a learned card in its signature
+};
+
+struct FrameColorDecision {
+  FrameColor color{FrameColor::white};
+  double similarity{0.0}; // 1 - Bhattacharyya distance to the signature
+  // How far the best signature beats the runner-up: 0 for a tie, 1 when
+  // the best one matches exactly
+  double confidence{0.0};
+};
+
+// Classifies the color of a warped card from the HSV histogram of its frame
+// (title bar, type line bar and side strips) on a small thumbnail, without
+// OCR. The histogram is compared against one signature per color class;
+// the signatures start from prototype frame colors and are refined by
+// cards the lookup confirmed. Safe to share between workflows on different
+// threads.
+class FrameColorClassifier {
+public:
+  explicit FrameColorClassifier(FrameColorConfig config = {});
+
+  [[nodiscard]] FrameColorDecision classify(const cv::Mat &warpedCard) const;
+
+  // Blend the card's histogram into the signature of its known color
+  void learn(const cv::Mat &warpedCard, FrameColor color);
+
+  [[nodiscard]] std::size_t learnedCount() const;
+
+  // Thumbnail size the frame regions are sampled at
+  static constexpr int thumbnailWidth = 68;
+  static constexpr int thumbnailHeight = 96;
+
+private:
+  [[nodiscard]] cv::Mat histogram(const cv::Mat &warpedCard) const;
+
+  FrameColorConfig config_;
+  cv::Mat mask_; // Frame regions on the thumbnail
+  mutable std::shared_mutex mutex_; // Guards signatures_ and learned_
+  std::array<cv::Mat, frame_color_count> signatures_;
+  std::size_t learned_{0};
+};
+
+} // namespace detect
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+namespace detect {
+
+// Thresholds for rejecting a warped card before OCR
+struct QualityConfig {
+  double minFocus{60.0};        // Minimum variance of the Laplacian
+  double maxClippedRatio{0.15}; // Maximum fraction of blown-out pixels
+  int clipLevel{250};           // Grey level counted as clipped
+};
+
+struct QualityScores {
+  double focus{0.0};        // Variance of the Laplacian over the text regions
+  double clippedRatio{0.0}; // Worst clipped fraction of any text region
+  bool sharp{false};
+  bool exposed{false}; // No region is washed out by glare
+
+  [[nodiscard]] bool acceptable() const { return sharp && exposed; }
+};
+
+// Fraction of pixels at or above clipLevel in a region
+[[nodiscard]] double clippedRatio(const cv::Mat &image, int clipLevel);
+
+// Score the given regions of a warped card. Focus is pooled over all regions
+// so small regions do not dominate; glare uses the worst region since one
+// washed-out field is enough to break the lookup.
+[[nodiscard]] QualityScores
+assessQuality(const cv::Mat &card, const std::vector<cv::Rect> &regions,
+              const QualityConfig &config = {});
+
+} // namespace detect
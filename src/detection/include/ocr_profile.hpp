@@ -0,0 +1,68 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace detect {
+
+// Denoising applied after the upscale, before the Otsu threshold
+enum class OcrFilter {
+  none,
+  median,   // 3x3, cheap
+  bilateral // Edge-preserving, the slowest at large scales
+};
+
+enum class OcrInterpolation { linear, cubic, lanczos };
+
+enum class OcrPreprocessing {
+  native, // Denoise and pick the threshold at native size, then upscale
+  legacy  // Upscale first, then denoise and threshold the large image
+};
+
+// How one text field is read: the model, the engine and the preprocessing
+struct FieldOcrSettings {
+  // "best" or "fast" for the traineddata downloaded at build time, otherwise
+  // a tessdata directory
+  std::string model{"best"};
+  std::string language{"eng"};
+  int engineMode{3};  // tesseract::OcrEngineMode (3 = default)
+  int pageSegMode{7}; // tesseract::PageSegMode (7 = single line)
+  std::string whitelist;
+  double scale{3.0};
+  OcrInterpolation interpolation{OcrInterpolation::cubic};
+  OcrFilter filter{OcrFilter::bilateral};
+  OcrPreprocessing preprocessing{OcrPreprocessing::native};
+};
+
+// The settings each reader used before profiles existed
+[[nodiscard]] FieldOcrSettings defaultCardNameSettings();
+[[nodiscard]] FieldOcrSettings defaultCollectorNumberSettings();
+[[nodiscard]] FieldOcrSettings defaultSetCodeSettings();
+
+// OCR settings for every field of a card. The default profile reads all of
+// them with tessdata_best.
+struct OcrProfile {
+  std::string name{"best"};
+  FieldOcrSettings cardName{defaultCardNameSettings()};
+  FieldOcrSettings collectorNumber{defaultCollectorNumberSettings()};
+  FieldOcrSettings setCode{defaultSetCodeSettings()};
+
+  // The setting the combined key pass cannot honor because the collector
+  // number and set code differ in it ("model", "language", "oem", "filter"
+  // or "preprocessing"), or empty if they agree. The pass always upscales
+  // both with the set code's scale and interpolation.
+  [[nodiscard]] std::string combinedKeyConflict() const;
+
+  // JSON file with a "name" and a "fields" object keyed by "name",
+  // "collector_number" and "set_code". Settings a field leaves out keep
+  // their default. Throws std::runtime_error if the file cannot be read or
+  // holds an unknown field, filter, interpolation or preprocessing.
+  [[nodiscard]] static OcrProfile load(const std::filesystem::path &path);
+};
+
+// A bare name ("fast") is a profile shipped in the data folder; anything
+// else is a path to a profile file
+[[nodiscard]] std::filesystem::path
+ocrProfilePath(const std::string &nameOrPath);
+
+} // namespace detect
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+namespace detect {
+
+// Tuning for the card presence/motion gate
+struct PresenceGateConfig {
+  int analysisWidth{64};      // Frames are analysed at this width
+  int pixelDiffThreshold{25}; // Grey-level change that counts as changed
+  double presenceRatio{0.08}; // Changed fraction vs. background = card
+  double motionRatio{0.01};   // Changed fraction vs. last frame = moving
+  int stableFrames{3};        // Still frames required before forwarding
+  int warmupFrames{5};        // Frames averaged into the first background
+  double learningRate{0.05};  // Background update rate while empty
+};
+
+enum class GateState {
+  learning, // Still building the empty-slot background
+  empty,    // No card in the slot
+  moving,   // Something is changing (card sliding in or out)
+  present   // A card is present and has been still for enough frames
+};
+
+struct GateDecision {
+  GateState state{GateState::learning};
+  double presence{0.0}; // Fraction of pixels differing from the background
+  double motion{0.0};   // Fraction of pixels differing from the last frame
+  bool forward{false};  // Run full detection on this frame
+  bool arrival{false};  // First forwarded frame of a new still period
+};
+
+// Cheap gate in front of detectCards: works on a tiny grey thumbnail,
+// compares it against a learned empty background (presence) and the previous
+// frame (motion), and forwards only frames with a card that has settled.
+class PresenceGate {
+public:
+  explicit PresenceGate(PresenceGateConfig config = {});
+
+  // Classify a BGR or grey frame
+  [[nodiscard]] GateDecision update(const cv::Mat &frame);
+
+  // Forget the background and start learning again
+  void reset();
+
+  [[nodiscard]] const PresenceGateConfig &config() const { return config_; }
+
+private:
+  [[nodiscard]] cv::Mat thumbnail(const cv::Mat &frame) const;
+  [[nodiscard]] double changedRatio(const cv::Mat &a, const cv::Mat &b) const;
+
+  PresenceGateConfig config_;
+  cv::Mat background_; // CV_32F running average of empty frames
+  cv::Mat previous_;   // CV_8U thumbnail of the previous frame
+  int learnedFrames_{0};
+  int stillFrames_{0};
+  bool forwarding_{false};
+};
+
+} // namespace detect
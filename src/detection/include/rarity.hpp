@@ -0,0 +1,76 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+
+namespace detect {
+
+// Rarity as the set symbol color shows it
+enum class Rarity {
+  common,   // Black
+  uncommon, // Silver
+  rare,     // Gold
+  mythic    // Orange-red
+};
+
+inline constexpr std::size_t rarity_count = 4;
+
+// Scryfall's name for the rarity ("common", ..., "mythic")
+[[nodiscard]] std::string_view rarityName(Rarity rarity);
+
+// Inverse of rarityName; empty for rarities without a symbol color
+// ("special", "bonus")
+[[nodiscard]] std::optional<Rarity> parseRarity(std::string_view name);
+
+struct RarityConfig {
+  // Pixels this far (BGR distance) from the type line background belong to
+  // the symbol or its outline
+  double minSymbolContrast{60.0};
+  double minSymbolRatio{0.05}; // Less of the region is no symbol at all
+  double learningRate{0.1};    // Weight of a learned card in its prototype
+};
+
+struct RarityDecision {
+  Rarity rarity{Rarity::common};
+  // How far the nearest prototype beats the runner-up; 0 if the region
+  // holds no symbol
+  double confidence{0.0};
+  double symbolRatio{0.0}; // Share of the region's pixels in the symbol
+};
+
+// Classifies the rarity from the color statistics of the set symbol
+// (extractSetSymbolRegionModern), without OCR. The symbol is the largest
+// blob standing out from the type line background, filled inside its
+// outline; the mean hue, saturation and value of its pixels are compared
+// with one prototype per rarity. The prototypes start as the printed symbol
+// colors and move towards cards the lookup confirmed. Safe to share between
+// workflows on different threads.
+class RarityClassifier {
+public:
+  explicit RarityClassifier(RarityConfig config = {});
+
+  [[nodiscard]] RarityDecision classify(const cv::Mat &symbol) const;
+
+  // Move the prototype of the confirmed rarity towards this symbol. False
+  // if the region holds no symbol.
+  bool learn(const cv::Mat &symbol, Rarity rarity);
+
+  [[nodiscard]] std::size_t learnedCount() const;
+
+private:
+  // Hue (as a vector scaled by saturation) and value of the symbol pixels
+  [[nodiscard]] std::optional<cv::Vec3d>
+  symbolColor(const cv::Mat &symbol, double &symbolRatio) const;
+
+  RarityConfig config_;
+  mutable std::shared_mutex mutex_; // Guards prototypes_ and learned_
+  std::array<cv::Vec3d, rarity_count> prototypes_;
+  std::size_t learned_{0};
+};
+
+} // namespace detect
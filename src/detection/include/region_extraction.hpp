@@ -6,7 +6,24 @@ namespace detect {
 [[nodiscard]] cv::Rect extractNameRegion(const cv::Mat &image);
 [[nodiscard]] cv::Rect extractCollectorNumberRegionModern(const cv::Mat &image);
 [[nodiscard]] cv::Rect extractSetNameRegionModern(const cv::Mat &image);
+[[nodiscard]] cv::Rect extractSetSymbolRegionModern(const cv::Mat &image);
 [[nodiscard]] cv::Rect extractArtRegionRegular(const cv::Mat &image);
 [[nodiscard]] cv::Rect extractTextRegion(const cv::Mat &image);
 
+// Projection profile thresholds for fitting a region to its text line
+struct TextLineConfig {
+  double minRowInk{0.02}; // Ink fraction of a row that makes it part of text
+  double maxRowInk{0.9};  // Rows with more ink are frame lines, not text
+  double maxWordGap{1.0}; // Wider column gaps (in line heights) end the text
+  double padding{0.25};   // Margin around the ink, in line heights
+  double minHeight{0.3};  // Thinner bands (of the region height) are noise
+};
+
+// Shrink a fixed-ratio region to the bounding box of its text line, so OCR
+// skips empty border and mana symbol pixels. Rows are kept where the ink
+// projection is dense, then columns from the leftmost block of ink. Returns
+// the region unchanged if it holds no plausible text line.
+[[nodiscard]] cv::Rect fitTextLine(const cv::Mat &image, const cv::Rect &region,
+                                   const TextLineConfig &config = {});
+
 } // namespace detect
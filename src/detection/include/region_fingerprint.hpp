@@ -0,0 +1,32 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace detect {
+
+// 512-bit fingerprint of a text region: the sign of the horizontal gradient
+// on a 65x8 grid, one 64-bit word per row. Contrast is stretched first, so
+// brightness and exposure changes between two photos of the same card keep
+// the fingerprint; steps below a small margin count as flat so plain bar
+// areas do not flip with sensor noise.
+struct RegionFingerprint {
+  std::array<std::uint64_t, 8> rows{};
+};
+
+[[nodiscard]] inline int hammingDistance(const RegionFingerprint &a,
+                                         const RegionFingerprint &b) {
+  int distance = 0;
+  for (std::size_t i = 0; i < a.rows.size(); ++i) {
+    distance += __builtin_popcountll(a.rows[i] ^ b.rows[i]);
+  }
+  return distance;
+}
+
+// Fingerprint a region crop (BGR or grey, any size)
+[[nodiscard]] RegionFingerprint fingerprintRegion(const cv::Mat &region);
+
+} // namespace detect
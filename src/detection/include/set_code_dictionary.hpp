@@ -0,0 +1,46 @@
+#pragma once
+
+#include <card_text_ocr.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace detect {
+
+struct SetCodeMatchConfig {
+  double minScore{0.35}; // Geometric mean probability per character
+  double minLead{1.2};   // Best score over the runner-up's
+};
+
+// Valid set codes, used to turn an OCR read into the code it most likely
+// is. Each candidate is scored per character against Tesseract's
+// alternatives at that position; a substitution Tesseract did not offer is
+// explained by a confusion model of letters that look alike in the set
+// code font. A read no valid code explains well enough becomes "unknown",
+// so it never costs a lookup that cannot succeed.
+class SetCodeDictionary {
+public:
+  explicit SetCodeDictionary(std::vector<std::string> codes,
+                             SetCodeMatchConfig config = {});
+
+  // Best valid code for the read with its score as confidence (0-100), or
+  // an empty text if no code is likely enough
+  [[nodiscard]] OcrResult correct(const OcrResult &read) const;
+
+  [[nodiscard]] bool contains(const std::string &code) const;
+  [[nodiscard]] std::size_t size() const { return codes_.size(); }
+
+  // Text file with one code per line; '#' starts a comment. Codes are
+  // uppercased; only letter codes the OCR can read are kept. Throws
+  // std::runtime_error if the file cannot be read or holds no codes.
+  [[nodiscard]] static SetCodeDictionary
+  load(const std::filesystem::path &path, SetCodeMatchConfig config = {});
+
+private:
+  std::vector<std::string> codes_; // Sorted, unique
+  SetCodeMatchConfig config_;
+};
+
+} // namespace detect
@@ -1,26 +1,101 @@
-
+#include <camera_stream.hpp>
 #include <detection_builder.hpp>
+#include <multi_card_workflow.hpp>
+#include <opencv_backend.hpp>
 #include <path_helper.hpp>
 #include <pic_helper.hpp>
+#include <presence_gate.hpp>
+#include <process_memory.hpp>
+#include <stopwatch.hpp>
+#include <stream_scanner.hpp>
+#include <thread_pool.hpp>
 
 #include <cxxopts.hpp>
 #include <gsl/span>
 #include <libassert/assert.hpp>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr double stats_interval_ms = 5000.0; // Stream statistics log period
+
+std::atomic<bool> stop_requested{false};
+
+void handleSignal(int /*signal*/) { stop_requested = true; }
+} // namespace
+
+struct CommandLineParameters {
+  std::filesystem::path imagePath;
+  std::string cameraSource; // Empty when processing a single file
+  double sourceFps{0.0};
+  std::size_t bufferSize{4};
+  bool presenceGate{true};
+  bool binderPage{false};             // Process every card in the image
+  bool qualityGate{true};             // Skip OCR for blurry or glared cards
+  detect::QualityConfig quality;
+  std::filesystem::path cardBackPath; // Optional card-back template image
+  std::filesystem::path artIndexPath; // Optional art hash index
+  std::filesystem::path setCodesPath; // Known set codes
+  std::string ocrProfile;             // Empty: the built-in best profile
+  bool parallelOcr{false};            // Read the text regions concurrently
+  std::filesystem::path binRulesPath; // Optional bin assignment rules
+  bool sortBeforeOcr{false};          // Bin by color and rarity alone
+  bool pinThreads{false};             // Pin the main thread and the workers
+};
 
-[[nodiscard]] std::filesystem::path getCommandLineParameters(int argc,
+[[nodiscard]] CommandLineParameters getCommandLineParameters(int argc,
                                                              char **argv) {
-  std::filesystem::path image_path;
+  CommandLineParameters params;
 
   try {
     cxxopts::Options options("card_scanner", "MTG Card Scanner");
     options.add_options()("f,file", "Process a card from an image file",
                           cxxopts::value<std::string>())(
+        "c,camera",
+        "Stream from a camera device index, video file or image sequence",
+        cxxopts::value<std::string>())(
+        "fps", "Replay file sources at this frame rate (0 = unthrottled)",
+        cxxopts::value<double>()->default_value("0"))(
+        "buffer", "Number of frames in the capture ring buffer",
+        cxxopts::value<std::size_t>()->default_value("4"))(
+        "no-presence-gate", "Run detection on every frame, even empty ones")(
+        "p,page", "The image holds several cards (e.g. a binder page)")(
+        "no-quality-gate", "Run OCR on every card regardless of sharpness")(
+        "min-focus", "Minimum Laplacian variance over the text regions",
+        cxxopts::value<double>()->default_value("60"))(
+        "max-clipped", "Maximum fraction of clipped pixels in a text region",
+        cxxopts::value<double>()->default_value("0.15"))(
+        "card-back", "Image of a card back used to detect face-down cards",
+        cxxopts::value<std::string>())(
+        "art-index", "Art hash index; a unique art match skips OCR",
+        cxxopts::value<std::string>())(
+        "set-codes", "File of valid set codes that OCR reads are matched to",
+        cxxopts::value<std::string>()->default_value(
+            (misc::getDataPath() / "set_codes.txt").string()))(
+        "ocr-profile",
+        "OCR settings per field: a shipped profile (fast, best) or a file",
+        cxxopts::value<std::string>()->default_value(""))(
+        "parallel-ocr", "Read the text regions of a card concurrently")(
+        "bin-rules", "Bin rules file to assign every card a bin",
+        cxxopts::value<std::string>())(
+        "sort-before-ocr", "Skip OCR for cards the bin rules decide by frame "
+                           "color and rarity")(
+        "pin-threads", "Pin the processing thread and the workers to cores")(
         "h,help", "Show this help message");
 
     auto result = options.parse(argc, argv);
@@ -30,10 +105,34 @@
       exit(0);
     }
 
-    if (result.count("file") > 0) {
-      image_path = result["file"].as<std::string>();
+    if (result.count("card-back") > 0) {
+      params.cardBackPath = result["card-back"].as<std::string>();
+    }
+    if (result.count("art-index") > 0) {
+      params.artIndexPath = result["art-index"].as<std::string>();
+    }
+    params.setCodesPath = result["set-codes"].as<std::string>();
+    params.qualityGate = result.count("no-quality-gate") == 0;
+    params.quality.minFocus = result["min-focus"].as<double>();
+    params.quality.maxClippedRatio = result["max-clipped"].as<double>();
+    params.ocrProfile = result["ocr-profile"].as<std::string>();
+    params.parallelOcr = result.count("parallel-ocr") > 0;
+    if (result.count("bin-rules") > 0) {
+      params.binRulesPath = result["bin-rules"].as<std::string>();
+    }
+    params.sortBeforeOcr = result.count("sort-before-ocr") > 0;
+    params.pinThreads = result.count("pin-threads") > 0;
+
+    if (result.count("camera") > 0) {
+      params.cameraSource = result["camera"].as<std::string>();
+      params.sourceFps = result["fps"].as<double>();
+      params.bufferSize = result["buffer"].as<std::size_t>();
+      params.presenceGate = result.count("no-presence-gate") == 0;
+    } else if (result.count("file") > 0) {
+      params.imagePath = result["file"].as<std::string>();
+      params.binderPage = result.count("page") > 0;
     } else {
-      spdlog::critical("Error: No input file specified");
+      spdlog::critical("Error: No input file or camera specified");
       spdlog::info("{}", options.help());
       abort();
     }
@@ -41,22 +140,330 @@
     spdlog::critical("Error parsing options: {}", e.what());
     abort();
   }
-  return image_path;
+  return params;
+}
+
+[[nodiscard]] workflow::WorkflowOptions
+getWorkflowOptions(const CommandLineParameters &params,
+                   const std::shared_ptr<misc::ThreadPool> &scheduler) {
+  workflow::WorkflowOptions options;
+  options.qualityGate = params.qualityGate;
+  options.quality = params.quality;
+  options.recognitionCache = std::make_shared<workflow::RecognitionCache>();
+  options.digitRecognizer = std::make_shared<detect::DigitRecognizer>();
+  options.frameColors = std::make_shared<detect::FrameColorClassifier>();
+  options.rarities = std::make_shared<detect::RarityClassifier>();
+  options.sortBeforeOcr = params.sortBeforeOcr;
+  if (!params.binRulesPath.empty()) {
+    try {
+      options.binSorter = std::make_shared<workflow::BinSorter>(
+          workflow::BinRules::load(params.binRulesPath));
+      spdlog::info("Loaded {} bin rules from {}",
+                   options.binSorter->rules()->size(),
+                   params.binRulesPath.string());
+    } catch (const std::runtime_error &e) {
+      spdlog::warn("{}, assigning no bins", e.what());
+    }
+  }
+  if (!params.cardBackPath.empty()) {
+    options.cardBackTemplate = cv::imread(params.cardBackPath.string());
+    if (options.cardBackTemplate.empty()) {
+      spdlog::warn("Could not read card back {}, using the color check",
+                   params.cardBackPath.string());
+    }
+  }
+  if (!params.artIndexPath.empty()) {
+    try {
+      options.artIndex = std::make_shared<const detect::ArtIndex>(
+          detect::ArtIndex::load(params.artIndexPath));
+      spdlog::info("Loaded {} art hashes", options.artIndex->size());
+    } catch (const std::runtime_error &e) {
+      spdlog::warn("{}, identifying by OCR only", e.what());
+    }
+  }
+  try {
+    options.setCodes = std::make_shared<const detect::SetCodeDictionary>(
+        detect::SetCodeDictionary::load(params.setCodesPath));
+  } catch (const std::runtime_error &e) {
+    spdlog::warn("{}, set codes are not checked", e.what());
+  }
+  if (!params.ocrProfile.empty()) {
+    try {
+      options.ocrProfile =
+          detect::OcrProfile::load(detect::ocrProfilePath(params.ocrProfile));
+      spdlog::info("Using OCR profile {}", options.ocrProfile.name);
+    } catch (const std::runtime_error &e) {
+      spdlog::warn("{}, using the best profile", e.what());
+    }
+  }
+  if (params.parallelOcr) {
+    options.ocrPool = scheduler;
+  }
+  return options;
+}
+
+// Resident memory, split into private pages (heap, including every Tesseract
+// engine's copy of its model) and file-backed pages (mapped libraries)
+void logMemory() {
+  auto memory = misc::readProcessMemory();
+  spdlog::info("Memory: {} MB resident ({} MB private, {} MB file-backed), "
+               "peak {} MB",
+               memory.residentKb / 1024, memory.anonymousKb / 1024,
+               memory.fileKb / 1024, memory.peakKb / 1024);
+}
+
+void logStreamStats(const capture::StreamStats &stats,
+                    std::uint64_t gatedFrames,
+                    const workflow::StreamScanner &scanner) {
+  spdlog::info("Capture {:.1f} fps, processing {:.1f} fps, {} captured, "
+               "{} processed, {} dropped, {} skipped by presence gate, "
+               "{} read by OCR, {} cards",
+               stats.captureFps, stats.processFps, stats.captured,
+               stats.processed, stats.dropped, gatedFrames,
+               scanner.framesRead(), scanner.cardsEmitted());
+  logMemory();
+}
+
+// Reload the bin rules if their file changed. Scanning goes on with the
+// old rules until the new ones are compiled; a broken file keeps them.
+void reloadBinRules(const std::filesystem::path &path,
+                    workflow::BinSorter &sorter,
+                    std::filesystem::file_time_type &lastWrite) {
+  std::error_code error;
+  auto write_time = std::filesystem::last_write_time(path, error);
+  if (error || write_time == lastWrite) {
+    return;
+  }
+  lastWrite = write_time;
+  try {
+    sorter.setRules(workflow::BinRules::load(path));
+    spdlog::info("Reloaded {} bin rules from {}", sorter.rules()->size(),
+                 path.string());
+  } catch (const std::runtime_error &e) {
+    spdlog::warn("{}, keeping the current bin rules", e.what());
+  }
+}
+
+// ", bin 3 (mythics)", or nothing without bin rules
+[[nodiscard]] std::string
+binText(const std::optional<workflow::BinDecision> &bin) {
+  if (!bin) {
+    return "";
+  }
+  return ", bin " + std::to_string(bin->bin) + " (" + bin->rule + ")";
+}
+
+void logScanResult(const std::optional<workflow::ScanResult> &result) {
+  if (!result) {
+    return;
+  }
+  const auto &consensus = result->consensus;
+  if (result->status == workflow::ScanStatus::flipNeeded) {
+    spdlog::warn("Card is face down, flip needed");
+  } else if (result->status == workflow::ScanStatus::notACard) {
+    spdlog::warn("Object on the platform is not a card");
+  } else if (result->status == workflow::ScanStatus::lowQuality) {
+    spdlog::warn("Card left before a sharp frame was read ({} frames)",
+                 result->framesSeen);
+  } else if (result->status == workflow::ScanStatus::sortedLocally) {
+    spdlog::info("Card: {} frame, {} symbol{}",
+                 result->frameColor
+                     ? detect::frameColorName(result->frameColor->color)
+                     : "unread",
+                 result->rarity ? detect::rarityName(result->rarity->rarity)
+                                : "unread",
+                 binText(result->bin));
+  } else if (result->status == workflow::ScanStatus::identified) {
+    const auto &info = *result->cardInfo;
+    if (consensus.frames == 0) {
+      spdlog::info("Card: {} ({} #{}) by art{}", info.name, info.setCode,
+                   info.collectorNumber, binText(result->bin));
+      return;
+    }
+    spdlog::info("Card: {} ({} #{}) after {} OCR frames{}", info.name,
+                 info.setCode, info.collectorNumber, consensus.frames,
+                 binText(result->bin));
+  } else {
+    spdlog::warn("Unidentified card after {} OCR frames: '{}' {} #{}",
+                 consensus.frames, consensus.cardName.text,
+                 consensus.setName.text, consensus.collectorNumber.text);
+  }
+}
+
+// The application's single scheduler: OpenCV's parallel regions, region
+// OCR and binder page cards all run on it. The calling thread takes part
+// in every parallel region, so one core is left for it.
+[[nodiscard]] std::shared_ptr<misc::ThreadPool>
+makeScheduler(const CommandLineParameters &params) {
+  // Tesseract would start its own OpenMP team per engine on top; must be
+  // set before the first engine is initialized
+  setenv("OMP_THREAD_LIMIT", "1", 0);
+
+  unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+  auto workers = std::max(1U, cores - 1);
+  if (params.pinThreads && !misc::pinCurrentThread(0)) {
+    spdlog::warn("Could not pin the processing thread to core 0");
+  }
+  // Workers take cores 1..n-1 and leave core 0 to the processing thread
+  auto scheduler =
+      std::make_shared<misc::ThreadPool>(workers, params.pinThreads, 1);
+  misc::installOpenCvBackend(scheduler);
+  spdlog::info("Scheduler with {} workers{}", scheduler->size(),
+               params.pinThreads ? ", pinned" : "");
+  return scheduler;
+}
+
+int runCamera(const CommandLineParameters &params,
+              const std::shared_ptr<misc::ThreadPool> &scheduler) {
+  capture::CameraStream stream(params.cameraSource, params.bufferSize,
+                               params.sourceFps);
+  if (!stream.start()) {
+    spdlog::critical("Error: Could not open capture source {}",
+                     params.cameraSource);
+    return 1;
+  }
+
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+
+  auto options = getWorkflowOptions(params, scheduler);
+  options.trackCorners = true;
+  workflow::DetectionWorkflow builder(workflow::CardType::modernNormal,
+                                      options);
+  workflow::StreamScanner scanner(builder);
+  detect::PresenceGate gate;
+  capture::CapturedFrame frame;
+  misc::Stopwatch stats_timer;
+  std::uint64_t gated_frames = 0;
+  std::filesystem::file_time_type rules_write_time;
+  if (options.binSorter) {
+    std::error_code error;
+    rules_write_time =
+        std::filesystem::last_write_time(params.binRulesPath, error);
+  }
+
+  while (!stop_requested && !stream.isExhausted()) {
+    if (stream.nextFrame(frame)) {
+      // Skip empty slots and cards still in motion before full detection
+      if (!params.presenceGate) {
+        // Without the gate there are no card boundaries: read every frame
+        // on its own
+        logScanResult(scanner.addFrame(frame.image));
+        logScanResult(scanner.endCard());
+      } else {
+        auto decision = gate.update(frame.image);
+        if (decision.arrival || decision.state == detect::GateState::empty) {
+          // The previous card is gone; emit it if still undecided
+          logScanResult(scanner.endCard());
+        }
+        if (decision.forward) {
+          logScanResult(scanner.addFrame(frame.image));
+        } else {
+          ++gated_frames;
+        }
+      }
+    }
+
+    if (stats_timer.elapsedMs() > stats_interval_ms) {
+      logStreamStats(stream.stats(), gated_frames, scanner);
+      if (options.binSorter) {
+        reloadBinRules(params.binRulesPath, *options.binSorter,
+                       rules_write_time);
+      }
+      stats_timer.reset();
+    }
+  }
+
+  stream.stop();
+  logScanResult(scanner.endCard());
+  logStreamStats(stream.stats(), gated_frames, scanner);
+  workflow::logCacheStats(options.recognitionCache->stats());
+  return 0;
+}
+
+int runBinderPage(const CommandLineParameters &params,
+                  const std::shared_ptr<misc::ThreadPool> &scheduler) {
+  const auto &image_path = params.imagePath;
+  auto options = getWorkflowOptions(params, scheduler);
+  workflow::MultiCardWorkflow flow(workflow::CardType::modernNormal, options,
+                                   scheduler);
+  misc::Stopwatch timer;
+  auto scans = flow.process(image_path);
+  spdlog::info("Processed {} cards in {:.0f} ms", scans.size(),
+               timer.elapsedMs());
+  workflow::logCacheStats(options.recognitionCache->stats());
+  logMemory();
+
+  // Overview: outline and number every card on the page
+  cv::Mat overview = cv::imread(image_path.string());
+  for (std::size_t i = 0; i < scans.size(); ++i) {
+    const auto &scan = scans[i];
+    bool identified = scan.status == workflow::ScanStatus::identified;
+    if (!scan.error.empty()) {
+      spdlog::warn("Card {}: {}", i + 1, scan.error);
+    } else if (scan.status == workflow::ScanStatus::flipNeeded) {
+      spdlog::warn("Card {}: face down, flip needed", i + 1);
+    } else if (scan.status == workflow::ScanStatus::sortedLocally) {
+      spdlog::info("Card {}: {} frame, {} symbol{}", i + 1,
+                   scan.frameColor
+                       ? detect::frameColorName(scan.frameColor->color)
+                       : "unread",
+                   scan.rarity ? detect::rarityName(scan.rarity->rarity)
+                               : "unread",
+                   binText(scan.bin));
+    } else if (identified) {
+      spdlog::info("Card {}: {} ({} #{}){}", i + 1, scan.cardInfo->name,
+                   scan.cardInfo->setCode, scan.cardInfo->collectorNumber,
+                   binText(scan.bin));
+    } else {
+      spdlog::warn("Card {}: not identified ('{}' {} #{})", i + 1,
+                   scan.cardName, scan.setName, scan.collectorNumber);
+    }
+
+    std::vector<cv::Point> outline(scan.corners.begin(), scan.corners.end());
+    cv::Scalar color =
+        identified ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 0, 255);
+    cv::polylines(overview, outline, true, color, 3);
+    cv::putText(overview, std::to_string(i + 1), outline[0] + cv::Point(10, 40),
+                cv::FONT_HERSHEY_SIMPLEX, 1.5, color, 3);
+  }
+
+  if (!misc::saveImage(misc::getTestSamplesPath(), overview, "test_out.jpg")) {
+    spdlog::critical("Error: Failed to save image");
+    return 1;
+  }
+  return scans.empty() ? 1 : 0;
 }
 
 int main(int argc, char *argv[]) {
 
-  auto image_path = getCommandLineParameters(argc, argv);
+  auto params = getCommandLineParameters(argc, argv);
+  auto scheduler = makeScheduler(params);
+
+  if (!params.cameraSource.empty()) {
+    return runCamera(params, scheduler);
+  }
 
+  const auto &image_path = params.imagePath;
   if (!std::filesystem::exists(image_path)) {
     spdlog::critical("Error: Input file does not exist: {}",
                      image_path.string());
     return 1;
   }
 
+  if (params.binderPage) {
+    try {
+      return runBinderPage(params, scheduler);
+    } catch (const std::runtime_error &e) {
+      spdlog::critical("Error processing page: {}", e.what());
+      return 1;
+    }
+  }
+
   try {
     // Create a detection builder for modern normal cards
-    workflow::DetectionWorkflow builder(workflow::CardType::modernNormal);
+    workflow::DetectionWorkflow builder(workflow::CardType::modernNormal,
+                                        getWorkflowOptions(params, scheduler));
 
     // Process the card using the builder
     auto processed_card = builder.process(image_path);
@@ -67,11 +474,16 @@ int main(int argc, char *argv[]) {
       return 1;
     }
 
+    if (builder.getBin()) {
+      spdlog::info("Bin {} ({})", builder.getBin()->bin,
+                   builder.getBin()->rule);
+    }
     spdlog::info("Processing completed successfully");
+    logMemory();
   } catch (const std::runtime_error &e) {
     spdlog::critical("Error processing card: {}", e.what());
     return 1;
   }
 
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,71 @@
+#include <opencv_backend.hpp>
+
+#include <opencv2/core.hpp>
+#include <spdlog/spdlog.h>
+
+#include <utility>
+
+#define CARD_SCANNER_OPENCV_BACKEND                                           \
+  (CV_VERSION_MAJOR > 4 ||                                                     \
+   (CV_VERSION_MAJOR == 4 &&                                                   \
+    (CV_VERSION_MINOR > 5 ||                                                   \
+     (CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 2))))
+
+#if CARD_SCANNER_OPENCV_BACKEND
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#endif
+
+namespace misc {
+
+#if CARD_SCANNER_OPENCV_BACKEND
+namespace {
+class PoolBackend : public cv::parallel::ParallelForAPI {
+public:
+  explicit PoolBackend(std::shared_ptr<ThreadPool> pool)
+      : pool_(std::move(pool)) {}
+
+  void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback,
+                    void *callback_data) override {
+    pool_->parallelFor(static_cast<std::size_t>(tasks),
+                       [body_callback, callback_data](std::size_t begin,
+                                                      std::size_t end) {
+                         body_callback(static_cast<int>(begin),
+                                       static_cast<int>(end), callback_data);
+                       });
+  }
+
+  // Workers are 1..n; the thread that started the region is 0
+  [[nodiscard]] int getThreadNum() const override {
+    return pool_->workerIndex() + 1;
+  }
+
+  [[nodiscard]] int getNumThreads() const override {
+    return static_cast<int>(pool_->size()) + 1;
+  }
+
+  // The pool is sized once for the whole application
+  int setNumThreads(int /*nThreads*/) override { return getNumThreads(); }
+
+  [[nodiscard]] const char *getName() const override {
+    return "card_scanner";
+  }
+
+private:
+  std::shared_ptr<ThreadPool> pool_;
+};
+} // namespace
+
+void installOpenCvBackend(std::shared_ptr<ThreadPool> pool) {
+  cv::parallel::setParallelForBackend(
+      std::make_shared<PoolBackend>(std::move(pool)), false);
+  spdlog::debug("OpenCV parallel regions run on the shared thread pool");
+}
+#else
+void installOpenCvBackend(std::shared_ptr<ThreadPool> /*pool*/) {
+  cv::setNumThreads(1);
+  spdlog::debug("OpenCV {} cannot use the shared pool, its threading is off",
+                CV_VERSION);
+}
+#endif
+
+} // namespace misc
@@ -7,4 +7,6 @@ std::filesystem::path getSamplesPath() { return {SAMPLE_DATA_FOLDER}; }
 
 std::filesystem::path getTestSamplesPath() { return {TEST_SAMPLES_FOLDER}; }
 
+std::filesystem::path getDataPath() { return {DATA_FOLDER}; }
+
 } // namespace misc
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include <process_memory.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace misc {
+
+ProcessMemory readProcessMemory() {
+  ProcessMemory memory;
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    std::size_t kilobytes = 0;
+    if (!(fields >> key >> kilobytes)) {
+      continue;
+    }
+    if (key == "VmRSS:") {
+      memory.residentKb = kilobytes;
+    } else if (key == "RssAnon:") {
+      memory.anonymousKb = kilobytes;
+    } else if (key == "RssFile:") {
+      memory.fileKb = kilobytes;
+    } else if (key == "VmHWM:") {
+      memory.peakKb = kilobytes;
+    }
+  }
+  return memory;
+}
+
+} // namespace misc
@@ -0,0 +1,219 @@
+#include <thread_pool.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace misc {
+
+namespace {
+// parallelFor splits its range into this many chunks per thread, so a
+// thread that started late or got preempted still finds work to steal
+constexpr std::size_t chunks_per_thread = 4;
+
+// The pool and index of the worker running on this thread
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+
+// Progress of one parallelFor call, shared with its helper tasks
+struct ForState {
+  std::atomic<std::size_t> next{0}; // First index not handed out yet
+  std::mutex mutex;                 // Guards done and error
+  std::condition_variable finished;
+  std::size_t done{0};
+  std::exception_ptr error;
+};
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads, bool pinThreads,
+                       unsigned firstCore) {
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  queues_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+
+  unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i, pinThreads, firstCore, cores]() {
+      if (pinThreads) {
+        auto core = static_cast<unsigned>((firstCore + i) % cores);
+        if (!pinCurrentThread(core)) {
+          spdlog::warn("Could not pin worker {} to core {}", i, core);
+        }
+      }
+      workerLoop(i);
+    });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  available_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::workerIndex() const {
+  return current_pool == this ? static_cast<int>(current_index) : -1;
+}
+
+void ThreadPool::push(std::function<void()> task) {
+  // Workers keep their own subtasks; outside submits are spread round robin
+  int self = workerIndex();
+  std::size_t target = self >= 0 ? static_cast<std::size_t>(self)
+                                 : nextQueue_++ % queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_;
+  }
+  available_.notify_one();
+}
+
+bool ThreadPool::pop(std::function<void()> &task) {
+  int self = workerIndex();
+  bool found = false;
+  if (self >= 0) {
+    // Own queue newest first: the subtask just queued is still in cache
+    auto &own = *queues_[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      found = true;
+    }
+  }
+
+  // Steal the oldest task of another queue, the one least likely to be hot
+  std::size_t start = self >= 0 ? static_cast<std::size_t>(self) + 1
+                                : nextQueue_.load();
+  for (std::size_t i = 0; !found && i < queues_.size(); ++i) {
+    auto &victim = *queues_[(start + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      found = true;
+    }
+  }
+
+  if (found) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --pending_;
+  }
+  return found;
+}
+
+bool ThreadPool::runPendingTask() {
+  std::function<void()> task;
+  if (!pop(task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void ThreadPool::parallelFor(
+    std::size_t count,
+    const std::function<void(std::size_t, std::size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+
+  auto state = std::make_shared<ForState>();
+  std::size_t threads = size() + 1; // The caller takes chunks too
+  std::size_t chunk = std::max<std::size_t>(
+      1, count / (threads * chunks_per_thread));
+  std::size_t chunks = (count + chunk - 1) / chunk;
+
+  // Helpers that start after the last chunk was handed out return at once
+  // and never touch body, which only lives until this call returns
+  auto run = [state, &body, count, chunk]() {
+    while (true) {
+      std::size_t begin = state->next.fetch_add(chunk);
+      if (begin >= count) {
+        return;
+      }
+      std::size_t end = std::min(begin + chunk, count);
+      std::exception_ptr error;
+      try {
+        body(begin, end);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (error && !state->error) {
+        state->error = error;
+      }
+      state->done += end - begin;
+      if (state->done == count) {
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  std::size_t helpers = std::min(size(), chunks - 1);
+  for (std::size_t i = 0; i < helpers; ++i) {
+    push(run);
+  }
+  run();
+
+  // Only chunks already running on other threads are left
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&state, count]() {
+    return state->done == count;
+  });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+  current_pool = this;
+  current_index = index;
+  while (true) {
+    if (runPendingTask()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    available_.wait(lock, [this]() { return stopping_ || pending_ > 0; });
+    // Drain the queues before stopping so no future is left unfulfilled
+    if (stopping_ && pending_ == 0) {
+      return;
+    }
+  }
+}
+
+bool pinCurrentThread(unsigned core) {
+#ifdef __linux__
+  if (core >= std::thread::hardware_concurrency()) {
+    return false;
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+  static_cast<void>(core);
+  return false;
+#endif
+}
+
+} // namespace misc
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <thread_pool.hpp>
+
+#include <memory>
+
+namespace misc {
+
+// Route OpenCV's own parallel regions (bilateralFilter, warpPerspective,
+// resize, ...) through the pool, so image processing, OCR and pipeline
+// tasks share one set of threads instead of oversubscribing the cores.
+// OpenCV older than 4.5.2 has no pluggable backend; its threading is then
+// switched off and the pool's tasks provide all the parallelism.
+void installOpenCvBackend(std::shared_ptr<ThreadPool> pool);
+
+} // namespace misc
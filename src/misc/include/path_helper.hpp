@@ -5,4 +5,6 @@
 namespace misc {
 [[nodiscard]] std::filesystem::path getSamplesPath();
 [[nodiscard]] std::filesystem::path getTestSamplesPath();
+// Runtime data shipped with the scanner (e.g. the set code list)
+[[nodiscard]] std::filesystem::path getDataPath();
 } // namespace misc
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace misc {
+
+// Memory of this process from /proc/self/status, in kilobytes. All zero
+// where the file does not exist.
+struct ProcessMemory {
+  std::size_t residentKb{0};  // VmRSS: anonymous plus file-backed pages
+  std::size_t anonymousKb{0}; // RssAnon: private heap and stacks
+  std::size_t fileKb{0};      // RssFile: pages of mapped files (libraries)
+  std::size_t peakKb{0};      // VmHWM: highest resident size so far
+};
+
+[[nodiscard]] ProcessMemory readProcessMemory();
+
+} // namespace misc
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+
+namespace misc {
+
+// Measures elapsed wall-clock time in milliseconds
+class Stopwatch {
+public:
+  Stopwatch() : start_(Clock::now()) {}
+
+  // Milliseconds since construction or the last lap/reset
+  [[nodiscard]] double elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start_)
+        .count();
+  }
+
+  // Return elapsed milliseconds and restart the measurement
+  double lap() {
+    auto now = Clock::now();
+    double elapsed =
+        std::chrono::duration<double, std::milli>(now - start_).count();
+    start_ = now;
+    return elapsed;
+  }
+
+  void reset() { start_ = Clock::now(); }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start_;
+};
+
+} // namespace misc
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace misc {
+
+// Work-stealing scheduler. Every worker owns a task deque: tasks submitted
+// from a worker go to its own deque and run newest first while the data is
+// still in cache, and idle workers steal the oldest task of a busy one.
+// Tasks may submit and wait for further tasks on the same pool.
+class ThreadPool {
+public:
+  // 0 threads means one per hardware thread. With pinThreads, worker i is
+  // bound to core (firstCore + i) modulo the core count.
+  explicit ThreadPool(std::size_t threads = 0, bool pinThreads = false,
+                      unsigned firstCore = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Queue a task; the future carries its result or exception
+  template <typename Task>
+  [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Task>>>
+  submit(Task &&task) {
+    using Result = std::invoke_result_t<std::decay_t<Task>>;
+    // std::function needs a copyable callable, packaged_task is move-only
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Task>(task));
+    auto future = packaged->get_future();
+    push([packaged]() { (*packaged)(); });
+    return future;
+  }
+
+  // Result of the future; runs queued tasks while it is not ready, so a
+  // task waiting on its subtasks never idles a worker or deadlocks the pool
+  template <typename Result> Result wait(std::future<Result> &future) {
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (!runPendingTask()) {
+        future.wait_for(std::chrono::microseconds(100));
+      }
+    }
+    return future.get();
+  }
+
+  // Calls body(begin, end) over chunks of [0, count) on the workers and the
+  // calling thread; returns when all chunks ran. The first exception a chunk
+  // throws is rethrown here.
+  void parallelFor(std::size_t count,
+                   const std::function<void(std::size_t, std::size_t)> &body);
+
+  // Run one queued task on the calling thread; false if there was none
+  bool runPendingTask();
+
+  [[nodiscard]] std::size_t size() const { return workers_.size(); }
+
+  // Index of the calling worker of this pool, or -1 on any other thread
+  [[nodiscard]] int workerIndex() const;
+
+private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void push(std::function<void()> task);
+  [[nodiscard]] bool pop(std::function<void()> &task);
+  void workerLoop(std::size_t index);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_; // One per worker
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> nextQueue_{0}; // Round robin for outside submits
+
+  std::mutex mutex_; // Guards pending_ and stopping_ for sleeping workers
+  std::condition_variable available_;
+  std::size_t pending_{0}; // Queued tasks not yet taken
+  bool stopping_{false};
+};
+
+// Bind the calling thread to one core, e.g. the thread of a latency-critical
+// stage. False if the platform or the core index does not allow it.
+bool pinCurrentThread(unsigned core);
+
+} // namespace misc
@@ -0,0 +1,137 @@
+#include <art_index.hpp>
+#include <card_detector.hpp>
+#include <stopwatch.hpp>
+
+#include <cxxopts.hpp>
+#include <opencv2/opencv.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct IndexedCard {
+  std::string id;
+  detect::ArtHash hash;
+};
+
+// Reference images are named after their Scryfall ID, e.g.
+// 0b7b2d4f-....jpg, as downloaded from the image_uris of a bulk export
+std::vector<IndexedCard> hashCards(const std::filesystem::path &directory,
+                                   bool detectSource) {
+  std::vector<IndexedCard> cards;
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    const auto &path = entry.path();
+    cv::Mat card;
+    if (detectSource) {
+      // Source is a photo of a card: cut out the card first
+      try {
+        card = detect::processCards(path);
+      } catch (const std::runtime_error &e) {
+        spdlog::warn("Skipping {}: {}", path.filename().string(), e.what());
+        continue;
+      }
+    } else {
+      cv::Mat image = cv::imread(path.string());
+      if (image.empty()) {
+        spdlog::warn("Skipping unreadable image: {}",
+                     path.filename().string());
+        continue;
+      }
+      // Scans are already cropped; bring them to the warped card size
+      cv::resize(image, card,
+                 cv::Size(detect::detail::normalizedWidth,
+                          detect::detail::normalizedHeight),
+                 0, 0, cv::INTER_AREA);
+    }
+
+    auto art = card(detect::artHashRegion(card));
+    cards.push_back({path.stem().string(), detect::computeArtHash(art)});
+    if (cards.size() % 1000 == 0) {
+      spdlog::info("Hashed {} cards", cards.size());
+    }
+  }
+  return cards;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  cxxopts::Options options("card_art_indexer",
+                           "Build the art hash index for OCR-free lookup");
+  options.add_options()("i,input",
+                        "Directory of reference images named <scryfall id>.*",
+                        cxxopts::value<std::string>())(
+      "o,output", "Index file to write",
+      cxxopts::value<std::string>()->default_value("art_index.txt"))(
+      "max-distance", "Match radius used for the lookup benchmark",
+      cxxopts::value<int>()->default_value("16"))(
+      "detect-source", "Inputs are photos; detect and warp the card first")(
+      "h,help", "Show this help message");
+
+  cxxopts::ParseResult args;
+  try {
+    args = options.parse(argc, argv);
+  } catch (const cxxopts::exceptions::exception &e) {
+    spdlog::critical("Error parsing options: {}", e.what());
+    return 1;
+  }
+
+  if (args.count("help") > 0) {
+    spdlog::info("{}", options.help());
+    return 0;
+  }
+  if (args.count("input") == 0) {
+    spdlog::critical("Error: No input directory specified");
+    spdlog::info("{}", options.help());
+    return 1;
+  }
+
+  std::filesystem::path input_dir = args["input"].as<std::string>();
+  if (!std::filesystem::is_directory(input_dir)) {
+    spdlog::critical("Error: Not a directory: {}", input_dir.string());
+    return 1;
+  }
+
+  auto cards = hashCards(input_dir, args.count("detect-source") > 0);
+  if (cards.empty()) {
+    spdlog::critical("Error: No reference images in {}", input_dir.string());
+    return 1;
+  }
+
+  detect::ArtIndex index;
+  for (const auto &card : cards) {
+    index.add(card.id, card.hash);
+  }
+
+  // Look every reference up again: lookup latency, and how many printings
+  // share their art with another one (those still need OCR at runtime)
+  const int max_distance = args["max-distance"].as<int>();
+  std::size_t shared_art = 0;
+  misc::Stopwatch timer;
+  for (const auto &card : cards) {
+    if (index.query(card.hash, max_distance).size() > 1) {
+      ++shared_art;
+    }
+  }
+  double lookup_us =
+      timer.elapsedMs() * 1000.0 / static_cast<double>(cards.size());
+  spdlog::info("{} cards indexed, {:.1f} us per lookup, {} share their art",
+               index.size(), lookup_us, shared_art);
+
+  std::filesystem::path output = args["output"].as<std::string>();
+  try {
+    index.save(output);
+  } catch (const std::runtime_error &e) {
+    spdlog::critical("Error: {}", e.what());
+    return 1;
+  }
+  spdlog::info("Wrote {}", output.string());
+  return 0;
+}
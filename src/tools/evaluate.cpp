@@ -0,0 +1,290 @@
+#include <detection_builder.hpp>
+#include <evaluation.hpp>
+#include <opencv_backend.hpp>
+#include <path_helper.hpp>
+#include <process_memory.hpp>
+#include <sample_label.hpp>
+#include <stopwatch.hpp>
+#include <thread_pool.hpp>
+
+#include <cxxopts.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+bench::EvalRecord evaluateImage(workflow::DetectionWorkflow &flow,
+                                const std::filesystem::path &imagePath,
+                                const bench::SampleLabel &label) {
+  bench::EvalRecord record;
+  record.file = imagePath.filename().string();
+  record.expected = label;
+
+  try {
+    std::ignore = flow.process(imagePath);
+  } catch (const std::exception &e) {
+    record.error = e.what();
+  }
+
+  record.name = flow.getCardName();
+  record.setCode = flow.getSetName();
+  record.collectorNumber = flow.getCollectorNumber();
+  record.focus = flow.getQuality().focus;
+  record.clippedRatio = flow.getQuality().clippedRatio;
+  record.sortedLocally =
+      flow.getStatus() == workflow::ScanStatus::sortedLocally;
+  record.rejected =
+      workflow::isRejected(flow.getStatus()) && !record.sortedLocally;
+  record.cacheHit = flow.isCacheHit();
+  record.artIdentified = flow.isArtIdentified();
+  // A failed image never reached OCR; it counts as a wrong name, not a
+  // skipped one
+  record.nameSkipped = record.error.empty() &&
+                       !workflow::isRejected(flow.getStatus()) &&
+                       !flow.wasNameRead() && record.name.empty();
+  record.digitsByTemplate = flow.usedDigitTemplates();
+  const auto &rarity = flow.getRarity();
+  if (rarity && rarity->confidence > 0.0) {
+    record.rarity = detect::rarityName(rarity->rarity);
+  }
+  if (const auto &bin = flow.getBin()) {
+    record.bin = bin->bin;
+    record.binRule = bin->rule;
+  }
+  if (!workflow::isRejected(flow.getStatus()) && record.error.empty()) {
+    const auto &crop = flow.getTextCrop();
+    record.textCrop = {{"name", crop.cardName},
+                       {"set_code", crop.setName},
+                       {"collector_number", crop.collectorNumber}};
+  }
+
+  const auto &info = flow.getCardInfo();
+  if (info && info->isValid) {
+    record.identified = true;
+    record.identifiedName = info->name;
+    record.identifiedSetCode = info->setCode;
+    record.identifiedCollectorNumber = info->collectorNumber;
+    record.identifiedRarity = info->rarity;
+  }
+
+  const auto &timings = flow.getTimings();
+  record.stageMs = {{"detect", timings.detectMs},
+                    {"face", timings.faceMs},
+                    {"orient", timings.orientMs},
+                    {"color", timings.colorMs},
+                    {"rarity", timings.rarityMs},
+                    {"tilt", timings.tiltMs},
+                    {"regions", timings.regionsMs},
+                    {"quality", timings.qualityMs},
+                    {"art", timings.artMs},
+                    {"cache", timings.cacheMs},
+                    {"ocr", timings.ocrMs},
+                    {"lookup", timings.lookupMs},
+                    {"sort", timings.sortMs},
+                    {"total", timings.totalMs()}};
+  return record;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  cxxopts::Options options("card_scanner_eval",
+                           "Measure accuracy and throughput on labeled images");
+  options.add_options()("d,dir", "Directory with labeled images",
+                        cxxopts::value<std::string>()->default_value(
+                            misc::getSamplesPath().string()))(
+      "o,report", "Write the JSON report to this file",
+      cxxopts::value<std::string>()->default_value(""))(
+      "t,tag", "Free-form label for this run (e.g. the configuration)",
+      cxxopts::value<std::string>()->default_value(""))(
+      "n,limit", "Evaluate at most this many images (0 = all)",
+      cxxopts::value<std::size_t>()->default_value("0"))(
+      "no-quality-gate", "Run OCR on every card regardless of sharpness")(
+      "min-focus", "Minimum Laplacian variance over the text regions",
+      cxxopts::value<double>()->default_value("60"))(
+      "max-clipped", "Maximum fraction of clipped pixels in a text region",
+      cxxopts::value<double>()->default_value("0.15"))(
+      "no-orientation", "Never rotate upside-down cards before OCR")(
+      "art-index", "Identify by art hash first (from card_art_indexer)",
+      cxxopts::value<std::string>()->default_value(""))(
+      "no-cache", "Run OCR on every image, even repeats of a known card")(
+      "eager-name", "Read the name even when the lookup key is confident")(
+      "parallel-ocr", "Read the text regions of a card concurrently")(
+      "combined-key-ocr", "Read the set code and collector number in one "
+                          "pass over the info block")(
+      "tesseract-digits", "Read collector numbers with Tesseract only")(
+      "set-codes", "File of valid set codes (empty = keep raw reads)",
+      cxxopts::value<std::string>()->default_value(
+          (misc::getDataPath() / "set_codes.txt").string()))(
+      "ocr-profile",
+      "OCR settings per field: a shipped profile (fast, best) or a file",
+      cxxopts::value<std::string>()->default_value(""))(
+      "frame-color", "Classify each card's frame color (the color stage)")(
+      "rarity", "Classify each card's rarity from its set symbol color")(
+      "bin-rules", "Assign bins with these rules (the sort stage)",
+      cxxopts::value<std::string>()->default_value(""))(
+      "sort-before-ocr", "Skip OCR for cards the bin rules decide by color "
+                         "and rarity")(
+      "no-text-crop", "OCR the fixed-ratio regions without fitting them to "
+                      "their text line")(
+      "legacy-preprocessing", "Upscale before denoising and thresholding "
+                              "(slower), whatever the profile says")(
+      "opencv-threads", "Keep OpenCV's own thread pool instead of the shared "
+                        "scheduler")(
+      "h,help", "Show this help message");
+
+  cxxopts::ParseResult args;
+  try {
+    args = options.parse(argc, argv);
+  } catch (const cxxopts::exceptions::exception &e) {
+    spdlog::critical("Error parsing options: {}", e.what());
+    return 1;
+  }
+
+  if (args.count("help") > 0) {
+    spdlog::info("{}", options.help());
+    return 0;
+  }
+
+  std::filesystem::path directory = args["dir"].as<std::string>();
+  if (!std::filesystem::is_directory(directory)) {
+    spdlog::critical("Error: Not a directory: {}", directory.string());
+    return 1;
+  }
+
+  auto labels = bench::collectLabels(directory);
+  if (labels.empty()) {
+    spdlog::critical("Error: No labeled images in {}", directory.string());
+    return 1;
+  }
+
+  auto limit = args["limit"].as<std::size_t>();
+  workflow::WorkflowOptions flow_options;
+  flow_options.qualityGate = args.count("no-quality-gate") == 0;
+  flow_options.quality.minFocus = args["min-focus"].as<double>();
+  flow_options.quality.maxClippedRatio = args["max-clipped"].as<double>();
+  flow_options.orientationCheck = args.count("no-orientation") == 0;
+  flow_options.lazyNameOcr = args.count("eager-name") == 0;
+  flow_options.combinedKeyOcr = args.count("combined-key-ocr") > 0;
+  flow_options.fitTextLines = args.count("no-text-crop") == 0;
+  if (args.count("frame-color") > 0) {
+    flow_options.frameColors = std::make_shared<detect::FrameColorClassifier>();
+  }
+  if (args.count("rarity") > 0) {
+    flow_options.rarities = std::make_shared<detect::RarityClassifier>();
+  }
+  flow_options.sortBeforeOcr = args.count("sort-before-ocr") > 0;
+  auto rules_path = args["bin-rules"].as<std::string>();
+  if (!rules_path.empty()) {
+    try {
+      flow_options.binSorter = std::make_shared<workflow::BinSorter>(
+          workflow::BinRules::load(rules_path));
+    } catch (const std::runtime_error &e) {
+      spdlog::critical("Error: {}", e.what());
+      return 1;
+    }
+  }
+  if (args.count("tesseract-digits") == 0) {
+    flow_options.digitRecognizer = std::make_shared<detect::DigitRecognizer>();
+  }
+  // Same scheduler as the scanner: one core for this thread, one worker
+  // for each of the others
+  setenv("OMP_THREAD_LIMIT", "1", 0);
+  auto scheduler = std::make_shared<misc::ThreadPool>(
+      std::max(2U, std::thread::hardware_concurrency()) - 1);
+  if (args.count("opencv-threads") == 0) {
+    misc::installOpenCvBackend(scheduler);
+  }
+  if (args.count("parallel-ocr") > 0) {
+    flow_options.ocrPool = scheduler;
+  }
+  auto set_codes_path = args["set-codes"].as<std::string>();
+  if (!set_codes_path.empty()) {
+    try {
+      flow_options.setCodes = std::make_shared<const detect::SetCodeDictionary>(
+          detect::SetCodeDictionary::load(set_codes_path));
+    } catch (const std::runtime_error &e) {
+      spdlog::critical("Error: {}", e.what());
+      return 1;
+    }
+  }
+  auto profile_name = args["ocr-profile"].as<std::string>();
+  if (!profile_name.empty()) {
+    try {
+      flow_options.ocrProfile =
+          detect::OcrProfile::load(detect::ocrProfilePath(profile_name));
+    } catch (const std::runtime_error &e) {
+      spdlog::critical("Error: {}", e.what());
+      return 1;
+    }
+  }
+  if (args.count("legacy-preprocessing") > 0) {
+    auto &profile = flow_options.ocrProfile;
+    for (auto *field :
+         {&profile.cardName, &profile.collectorNumber, &profile.setCode}) {
+      field->preprocessing = detect::OcrPreprocessing::legacy;
+    }
+  }
+  auto art_index_path = args["art-index"].as<std::string>();
+  if (!art_index_path.empty()) {
+    try {
+      flow_options.artIndex = std::make_shared<const detect::ArtIndex>(
+          detect::ArtIndex::load(art_index_path));
+    } catch (const std::runtime_error &e) {
+      spdlog::critical("Error: {}", e.what());
+      return 1;
+    }
+  }
+  if (args.count("no-cache") == 0) {
+    flow_options.recognitionCache =
+        std::make_shared<workflow::RecognitionCache>();
+  }
+  workflow::DetectionWorkflow flow(workflow::CardType::modernNormal,
+                                   flow_options);
+  std::vector<bench::EvalRecord> records;
+
+  misc::Stopwatch wall_clock;
+  for (const auto &[file_name, label] : labels) {
+    if (limit > 0 && records.size() >= limit) {
+      break;
+    }
+    records.push_back(evaluateImage(flow, directory / file_name, label));
+  }
+  double wall_time_ms = wall_clock.elapsedMs();
+
+  auto summary = bench::summarize(records, wall_time_ms);
+  if (flow_options.recognitionCache) {
+    summary.cacheSavedMs = flow_options.recognitionCache->stats().savedMs;
+  }
+  auto memory = misc::readProcessMemory();
+  summary.residentMb = static_cast<double>(memory.residentKb) / 1024.0;
+  summary.fileBackedMb = static_cast<double>(memory.fileKb) / 1024.0;
+  summary.peakResidentMb = static_cast<double>(memory.peakKb) / 1024.0;
+  bench::logSummary(summary);
+
+  auto report_path = args["report"].as<std::string>();
+  if (!report_path.empty()) {
+    std::ofstream report(report_path);
+    if (!report.is_open()) {
+      spdlog::critical("Error: Failed to write report {}", report_path);
+      return 1;
+    }
+    // Untagged runs are labeled with the profile they measured
+    auto tag = args["tag"].as<std::string>();
+    if (tag.empty()) {
+      tag = flow_options.ocrProfile.name;
+    }
+    report << bench::toJson(summary, records, tag);
+    spdlog::info("Wrote report to {}", report_path);
+  }
+  return 0;
+}
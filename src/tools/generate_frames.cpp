@@ -0,0 +1,172 @@
+#include <card_detector.hpp>
+#include <frame_synthesizer.hpp>
+#include <path_helper.hpp>
+#include <sample_label.hpp>
+
+#include <cxxopts.hpp>
+#include <opencv2/opencv.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct SourceCard {
+  cv::Mat image;
+  bench::SampleLabel label;
+};
+
+std::vector<cv::Mat> loadBackgrounds(const std::filesystem::path &directory) {
+  std::vector<cv::Mat> backgrounds;
+  if (directory.empty()) {
+    return backgrounds;
+  }
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    cv::Mat image = cv::imread(entry.path().string());
+    if (!image.empty()) {
+      backgrounds.push_back(image);
+    }
+  }
+  spdlog::info("Loaded {} background images", backgrounds.size());
+  return backgrounds;
+}
+
+std::vector<SourceCard> loadCards(const std::filesystem::path &directory,
+                                  bool detectSource) {
+  std::vector<SourceCard> cards;
+  auto labels = bench::collectLabels(directory);
+
+  for (const auto &[file_name, label] : labels) {
+    auto path = directory / file_name;
+    cv::Mat image;
+    if (detectSource) {
+      // Source is a photo of a card: cut out the card first
+      try {
+        image = detect::processCards(path);
+      } catch (const std::runtime_error &e) {
+        spdlog::warn("Skipping {}: {}", file_name, e.what());
+        continue;
+      }
+    } else {
+      image = cv::imread(path.string());
+    }
+
+    if (image.empty()) {
+      spdlog::warn("Skipping unreadable card image: {}", file_name);
+      continue;
+    }
+    cards.push_back({image, label});
+  }
+  spdlog::info("Loaded {} labeled source cards", cards.size());
+  return cards;
+}
+
+std::string frameName(int index) {
+  std::ostringstream name;
+  name << "frame_" << std::setw(6) << std::setfill('0') << index << ".jpg";
+  return name.str();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  cxxopts::Options options("card_frame_generator",
+                           "Generate labeled synthetic card frames");
+  options.add_options()("i,input", "Directory with labeled card images",
+                        cxxopts::value<std::string>()->default_value(
+                            misc::getSamplesPath().string()))(
+      "b,backgrounds", "Directory with background images",
+      cxxopts::value<std::string>()->default_value(""))(
+      "o,output", "Output directory for frames and labels.csv",
+      cxxopts::value<std::string>())(
+      "n,count", "Number of frames to generate",
+      cxxopts::value<int>()->default_value("1000"))(
+      "W,width", "Frame width", cxxopts::value<int>()->default_value("1280"))(
+      "H,height", "Frame height", cxxopts::value<int>()->default_value("960"))(
+      "s,seed", "Random seed (same seed gives the same corpus)",
+      cxxopts::value<std::uint64_t>()->default_value("1"))(
+      "detect-source", "Inputs are photos; detect and warp the card first")(
+      "h,help", "Show this help message");
+
+  cxxopts::ParseResult args;
+  try {
+    args = options.parse(argc, argv);
+  } catch (const cxxopts::exceptions::exception &e) {
+    spdlog::critical("Error parsing options: {}", e.what());
+    return 1;
+  }
+
+  if (args.count("help") > 0) {
+    spdlog::info("{}", options.help());
+    return 0;
+  }
+  if (args.count("output") == 0) {
+    spdlog::critical("Error: No output directory specified");
+    spdlog::info("{}", options.help());
+    return 1;
+  }
+
+  std::filesystem::path output_dir = args["output"].as<std::string>();
+  std::filesystem::create_directories(output_dir);
+
+  auto cards = loadCards(args["input"].as<std::string>(),
+                         args.count("detect-source") > 0);
+  if (cards.empty()) {
+    spdlog::critical("Error: No labeled card images found");
+    return 1;
+  }
+  auto backgrounds = loadBackgrounds(args["backgrounds"].as<std::string>());
+
+  bench::SynthesisParams params;
+  params.frameSize =
+      cv::Size(args["width"].as<int>(), args["height"].as<int>());
+  bench::FrameSynthesizer synthesizer(params, args["seed"].as<std::uint64_t>());
+
+  // Card and background choice use their own stream so they stay stable
+  // if the synthesizer's randomization changes
+  cv::RNG pick(~args["seed"].as<std::uint64_t>());
+
+  const int count = args["count"].as<int>();
+  bench::LabelMap labels;
+  for (int i = 0; i < count; ++i) {
+    const auto &card = cards[pick.uniform(0, static_cast<int>(cards.size()))];
+    cv::Mat background;
+    if (!backgrounds.empty()) {
+      background =
+          backgrounds[pick.uniform(0, static_cast<int>(backgrounds.size()))];
+    }
+
+    bench::SyntheticFrame frame;
+    try {
+      frame = synthesizer.generate(card.image, background);
+    } catch (const std::runtime_error &e) {
+      spdlog::critical("Error: {}", e.what());
+      return 1;
+    }
+    auto name = frameName(i);
+    if (!cv::imwrite((output_dir / name).string(), frame.image)) {
+      spdlog::critical("Error: Failed to write {}", name);
+      return 1;
+    }
+
+    bench::SampleLabel label = card.label;
+    label.corners = frame.corners;
+    labels[name] = label;
+
+    if ((i + 1) % 1000 == 0) {
+      spdlog::info("Generated {}/{} frames", i + 1, count);
+    }
+  }
+
+  if (!bench::writeLabelCsv(output_dir / "labels.csv", labels)) {
+    return 1;
+  }
+  spdlog::info("Wrote {} frames to {}", count, output_dir.string());
+  return 0;
+}
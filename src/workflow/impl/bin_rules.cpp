@@ -0,0 +1,337 @@
+#include <bin_rules.hpp>
+
+#include <libassert/assert.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace workflow {
+
+namespace {
+constexpr int max_type_words = 64; // One bit each in a type mask
+
+std::string toLower(std::string text) {
+  std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  return text;
+}
+
+// Words of a type line, lowercased; the dash and punctuation separate them
+std::vector<std::string> typeWords(const std::string &typeLine) {
+  std::vector<std::string> words;
+  std::string word;
+  for (char c : typeLine) {
+    if (std::isalpha(static_cast<unsigned char>(c)) != 0) {
+      word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    } else if (!word.empty()) {
+      words.push_back(std::move(word));
+      word.clear();
+    }
+  }
+  if (!word.empty()) {
+    words.push_back(std::move(word));
+  }
+  return words;
+}
+
+std::vector<std::string> stringList(const nlohmann::json &value) {
+  if (value.is_string()) {
+    return {value.get<std::string>()};
+  }
+  return value.get<std::vector<std::string>>();
+}
+
+int parseBin(const nlohmann::json &value) {
+  int bin = value.get<int>();
+  if (bin < 0 || bin >= max_bins) {
+    throw std::runtime_error("Bin out of range: " + std::to_string(bin));
+  }
+  return bin;
+}
+
+std::uint64_t binBit(int bin) { return std::uint64_t{1} << bin; }
+} // namespace
+
+CardFeatures cardFeatures(const api::CardInfo &card) {
+  CardFeatures features;
+  features.setCode = toLower(card.setCode);
+  features.rarity = detect::parseRarity(card.rarity);
+  features.typeLine = card.typeLine;
+  if (card.priceUsd > 0.0) {
+    features.priceUsd = card.priceUsd; // Scryfall has no USD price otherwise
+  }
+  features.complete = true;
+
+  if (card.colors.size() > 1) {
+    features.color = detect::FrameColor::multicolor;
+  } else if (card.colors.empty()) {
+    auto words = typeWords(card.typeLine);
+    bool land = std::find(words.begin(), words.end(), "land") != words.end();
+    features.color =
+        land ? detect::FrameColor::land : detect::FrameColor::artifact;
+  } else {
+    switch (card.colors.front()) {
+    case 'W':
+      features.color = detect::FrameColor::white;
+      break;
+    case 'U':
+      features.color = detect::FrameColor::blue;
+      break;
+    case 'B':
+      features.color = detect::FrameColor::black;
+      break;
+    case 'R':
+      features.color = detect::FrameColor::red;
+      break;
+    case 'G':
+      features.color = detect::FrameColor::green;
+      break;
+    default:
+      break;
+    }
+  }
+  return features;
+}
+
+BinRules BinRules::load(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot read bin rules: " + path.string());
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto rules = parse(buffer.str());
+  if (rules.name_.empty()) {
+    rules.name_ = path.stem().string();
+  }
+  return rules;
+}
+
+BinRules BinRules::parse(const std::string &json) {
+  BinRules rules;
+  try {
+    auto config = nlohmann::json::parse(json);
+    for (const auto &[key, value] : config.items()) {
+      if (key == "name") {
+        rules.name_ = value.get<std::string>();
+      } else if (key == "default_bin") {
+        rules.defaultBin_ = parseBin(value);
+      } else if (key != "rules") {
+        throw std::runtime_error("Unknown bin rules key: " + key);
+      }
+    }
+    if (!config.contains("rules")) {
+      return rules;
+    }
+
+    for (const auto &entry : config["rules"]) {
+      Rule rule;
+      rule.name = "rule " + std::to_string(rules.rules_.size() + 1);
+      bool has_bin = false;
+      for (const auto &[key, value] : entry.items()) {
+        if (key == "name") {
+          rule.name = value.get<std::string>();
+        } else if (key == "bin") {
+          rule.bin = parseBin(value);
+          has_bin = true;
+        } else if (key == "set") {
+          for (const auto &code : stringList(value)) {
+            auto id = static_cast<int>(rules.setIds_.size());
+            rule.sets.push_back(
+                rules.setIds_.emplace(toLower(code), id).first->second);
+          }
+          std::sort(rule.sets.begin(), rule.sets.end());
+        } else if (key == "rarity") {
+          for (const auto &name : stringList(value)) {
+            auto rarity = detect::parseRarity(name);
+            if (!rarity) {
+              throw std::runtime_error("Unknown rarity: " + name);
+            }
+            rule.rarities |= 1U << static_cast<unsigned>(*rarity);
+          }
+        } else if (key == "color") {
+          for (const auto &name : stringList(value)) {
+            auto color = detect::parseFrameColor(name);
+            if (!color) {
+              throw std::runtime_error("Unknown color: " + name);
+            }
+            rule.colors |= 1U << static_cast<unsigned>(*color);
+          }
+        } else if (key == "type") {
+          for (const auto &type : stringList(value)) {
+            rule.types |= std::uint64_t{1} << rules.internType(type);
+          }
+        } else if (key == "min_usd") {
+          rule.minUsd = value.get<double>();
+        } else if (key == "max_usd") {
+          rule.maxUsd = value.get<double>();
+        } else {
+          throw std::runtime_error("Unknown bin rule key: " + key);
+        }
+      }
+      if (!has_bin) {
+        throw std::runtime_error("Bin rule without a bin: " + rule.name);
+      }
+      rules.rules_.push_back(std::move(rule));
+    }
+  } catch (const nlohmann::json::exception &e) {
+    throw std::runtime_error(std::string("Invalid bin rules: ") + e.what());
+  }
+  return rules;
+}
+
+int BinRules::internType(const std::string &type) {
+  auto words = typeWords(type);
+  if (words.size() != 1) {
+    throw std::runtime_error("Bin rule type must be one word: " + type);
+  }
+  auto it = typeIds_.find(words.front());
+  if (it != typeIds_.end()) {
+    return it->second;
+  }
+  if (typeIds_.size() >= max_type_words) {
+    throw std::runtime_error("Too many distinct types in bin rules");
+  }
+  auto id = static_cast<int>(typeIds_.size());
+  typeIds_.emplace(words.front(), id);
+  return id;
+}
+
+std::uint64_t BinRules::typeMask(const std::string &typeLine) const {
+  std::uint64_t mask = 0;
+  for (const auto &word : typeWords(typeLine)) {
+    auto it = typeIds_.find(word);
+    if (it != typeIds_.end()) {
+      mask |= std::uint64_t{1} << it->second;
+    }
+  }
+  return mask;
+}
+
+BinRules::Match BinRules::match(const Rule &rule, const CardFeatures &card,
+                                std::optional<int> setId,
+                                std::uint64_t cardTypes) {
+  // A predicate on an unread feature leaves the rule open; after the
+  // lookup a missing feature simply fails
+  bool open = false;
+  auto holds = [&open, &card](bool known, bool matches) {
+    if (known) {
+      return matches;
+    }
+    if (card.complete) {
+      return false;
+    }
+    open = true;
+    return true;
+  };
+
+  if (!rule.sets.empty()) {
+    bool matches = setId && std::binary_search(rule.sets.begin(),
+                                               rule.sets.end(), *setId);
+    if (!holds(!card.setCode.empty(), matches)) {
+      return Match::no;
+    }
+  }
+  if (rule.rarities != 0) {
+    bool matches =
+        card.rarity &&
+        (rule.rarities & (1U << static_cast<unsigned>(*card.rarity))) != 0;
+    if (!holds(card.rarity.has_value(), matches)) {
+      return Match::no;
+    }
+  }
+  if (rule.colors != 0) {
+    bool matches =
+        card.color &&
+        (rule.colors & (1U << static_cast<unsigned>(*card.color))) != 0;
+    if (!holds(card.color.has_value(), matches)) {
+      return Match::no;
+    }
+  }
+  if (rule.types != 0 &&
+      !holds(card.typeLine.has_value(), (rule.types & cardTypes) != 0)) {
+    return Match::no;
+  }
+  if (rule.minUsd &&
+      !holds(card.priceUsd.has_value(),
+             card.priceUsd && *card.priceUsd >= *rule.minUsd)) {
+    return Match::no;
+  }
+  if (rule.maxUsd &&
+      !holds(card.priceUsd.has_value(),
+             card.priceUsd && *card.priceUsd <= *rule.maxUsd)) {
+    return Match::no;
+  }
+  return open ? Match::unknown : Match::yes;
+}
+
+BinDecision BinRules::evaluate(const CardFeatures &card,
+                               std::uint64_t fullBins) const {
+  // Per card, not per rule: one hash lookup for the set, one per type word
+  std::optional<int> set_id;
+  if (auto it = setIds_.find(card.setCode); it != setIds_.end()) {
+    set_id = it->second;
+  }
+  std::uint64_t type_mask = card.typeLine ? typeMask(*card.typeLine) : 0;
+
+  BinDecision decision;
+  for (const auto &rule : rules_) {
+    if ((fullBins & binBit(rule.bin)) != 0) {
+      continue;
+    }
+    switch (match(rule, card, set_id, type_mask)) {
+    case Match::no:
+      continue;
+    case Match::unknown:
+      // This rule may still fire once the card is read; a later one must
+      // not take it first
+      return decision;
+    case Match::yes:
+      decision.decided = true;
+      decision.bin = rule.bin;
+      decision.rule = rule.name;
+      return decision;
+    }
+  }
+  decision.decided = true;
+  decision.bin = defaultBin_;
+  decision.rule = "default";
+  return decision;
+}
+
+BinSorter::BinSorter(BinRules rules)
+    : rules_(std::make_shared<const BinRules>(std::move(rules))) {}
+
+BinDecision BinSorter::assign(const CardFeatures &card) const {
+  return rules()->evaluate(card, fullBins_.load(std::memory_order_relaxed));
+}
+
+void BinSorter::setRules(BinRules rules) {
+  std::atomic_store(&rules_,
+                    std::make_shared<const BinRules>(std::move(rules)));
+}
+
+std::shared_ptr<const BinRules> BinSorter::rules() const {
+  return std::atomic_load(&rules_);
+}
+
+void BinSorter::setBinFull(int bin, bool full) {
+  ASSERT(bin >= 0 && bin < max_bins, "Bin out of range", bin);
+  if (full) {
+    fullBins_.fetch_or(binBit(bin), std::memory_order_relaxed);
+  } else {
+    fullBins_.fetch_and(~binBit(bin), std::memory_order_relaxed);
+  }
+}
+
+bool BinSorter::isBinFull(int bin) const {
+  ASSERT(bin >= 0 && bin < max_bins, "Bin out of range", bin);
+  return (fullBins_.load(std::memory_order_relaxed) & binBit(bin)) != 0;
+}
+
+} // namespace workflow
@@ -3,51 +3,455 @@
 #include <detection_builder.hpp>
 #include <region_extraction.hpp>
 #include <scryfall_client.hpp>
+#include <stopwatch.hpp>
 #include <tilt_corrector.hpp>
 
 #include <libassert/assert.hpp>
 #include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <future>
 #include <stdexcept>
+#include <tuple>
 
 namespace workflow {
 
-DetectionWorkflow::DetectionWorkflow(CardType type) : type_(type) {}
+namespace {
+std::string normalizedKey(const std::string &text, bool stripZeros) {
+  std::string key;
+  for (char c : text) {
+    if (stripZeros && key.empty() && c == '0') {
+      continue;
+    }
+    key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return key;
+}
+
+// The lookup returned the printing that was read. Collector numbers are
+// printed with leading zeros that Scryfall leaves out.
+bool isReadPrinting(const api::CardInfo &card, const std::string &setCode,
+                    const std::string &collectorNumber) {
+  return normalizedKey(card.setCode, false) ==
+             normalizedKey(setCode, false) &&
+         normalizedKey(card.collectorNumber, true) ==
+             normalizedKey(collectorNumber, true);
+}
+} // namespace
+
+DetectionWorkflow::DetectionWorkflow(
+    CardType type, WorkflowOptions options,
+    std::shared_ptr<api::ScryfallClient> scryfallClient)
+    : type_(type), options_(options),
+      scryfallClient_(scryfallClient
+                          ? std::move(scryfallClient)
+                          : std::make_shared<api::ScryfallClient>()),
+      faceClassifier_(options.face), tracker_(options.tracker) {
+  if (!options_.cardBackTemplate.empty()) {
+    faceClassifier_.setBackTemplate(options_.cardBackTemplate);
+  }
+  if (options_.combinedKeyOcr) {
+    // One pass reads both fields with one engine and one preprocessing
+    auto conflict = options_.ocrProfile.combinedKeyConflict();
+    if (!conflict.empty()) {
+      spdlog::warn("OCR profile '{}' sets a different {} for the collector "
+                   "number and set code, reading them separately",
+                   options_.ocrProfile.name, conflict);
+      options_.combinedKeyOcr = false;
+    }
+  }
+}
 
 cv::Mat DetectionWorkflow::process(const std::filesystem::path &imagePath) {
+  ASSERT(!imagePath.empty(), "Image path is empty");
+  resetResults();
+
+  // Detect and warp the card
+  misc::Stopwatch timer;
+  auto card = detect::processCards(imagePath);
+  timings_.detectMs = timer.lap();
+
+  return processCard(card);
+}
+
+cv::Mat DetectionWorkflow::process(const cv::Mat &frame) {
+  resetResults();
+  return processCard(locateCard(frame));
+}
+
+cv::Mat DetectionWorkflow::processWarped(const cv::Mat &card) {
+  ASSERT(!card.empty(), "Card image is empty");
+  resetResults();
+  return processCard(card);
+}
+
+cv::Mat DetectionWorkflow::recognize(const cv::Mat &frame) {
+  resetResults();
+  return recognizeCard(locateCard(frame));
+}
+
+void DetectionWorkflow::identify(const std::string &cardName,
+                                 const std::string &setName,
+                                 const std::string &collectorNumber) {
+  cardName_ = cardName;
+  setName_ = setName;
+  collectorNumber_ = collectorNumber;
+  cardInfo_.reset();
+  printingConfirmed_ = false;
+  bin_.reset();
+
+  misc::Stopwatch timer;
+  double ocr_ms = timings_.ocrMs;
+  lookupCardInfo();
+  dropPendingName(); // Identified by the key; the name is not needed
+  // A deferred name read is OCR time, not lookup time
+  timings_.lookupMs = timer.lap() - (timings_.ocrMs - ocr_ms);
+  status_ = cardInfo_ && cardInfo_->isValid ? ScanStatus::identified
+                                            : ScanStatus::unidentified;
+  if (status_ == ScanStatus::identified) {
+    rememberRecognition();
+    learnDigits();
+    checkRarity();
+    learnFrameColor();
+    assignBin();
+  }
+}
+
+cv::Mat DetectionWorkflow::locateCard(const cv::Mat &frame) {
+  // Detect and warp the card
+  misc::Stopwatch timer;
+  cv::Mat card;
+  if (options_.trackCorners) {
+    // Reuse the corners from the previous frame where possible
+    auto tracked = tracker_.track(frame);
+    trackSource_ = tracked.source;
+    if (!tracked.found()) {
+      throw std::runtime_error("no cards detected");
+    }
+    card = tracked.card;
+  } else {
+    card = detect::processFrame(frame);
+    trackSource_ = detect::TrackSource::full;
+  }
+  timings_.detectMs = timer.lap();
+  return card;
+}
+
+bool DetectionWorkflow::identifyByArt() {
+  ASSERT(hasArtMatch(), "No unique art match to identify");
+  misc::Stopwatch timer;
+  cardInfo_ = scryfallClient_->getCardById(artCardId_);
+  timings_.lookupMs = timer.lap();
+
+  if (!cardInfo_ || !cardInfo_->isValid) {
+    spdlog::warn("Art match {} not found, falling back to OCR", artCardId_);
+    cardInfo_.reset();
+    status_ = ScanStatus::unidentified;
+    readCardText();
+    return false;
+  }
+
+  cardName_ = cardInfo_->name;
+  setName_ = cardInfo_->setCode;
+  collectorNumber_ = cardInfo_->collectorNumber;
+  status_ = ScanStatus::identified;
+  artIdentified_ = true;
+  // The art pinned the Scryfall ID; later scans of the text regions can
+  // recall it
+  printingConfirmed_ = true;
+  if (options_.recognitionCache) {
+    misc::Stopwatch cache_timer;
+    fingerprints_ = fingerprintRegions();
+    timings_.cacheMs += cache_timer.lap();
+    rememberRecognition();
+  }
+  checkRarity();
+  learnFrameColor();
+  assignBin();
+  spdlog::info("=== Card Identified (by art) ===");
+  spdlog::info("Name: {}", cardInfo_->name);
+  spdlog::info("Set: {} ({})", cardInfo_->setName, cardInfo_->setCode);
+  spdlog::info("Collector #: {}", cardInfo_->collectorNumber);
+  return true;
+}
+
+cv::Mat DetectionWorkflow::processCard(const cv::Mat &card) {
+  cv::Mat result = recognizeCard(card);
+  if (hasArtMatch()) {
+    std::ignore = identifyByArt();
+  }
+  // Read by OCR, not identified by art or cache and not rejected
+  if (status_ == ScanStatus::unidentified) {
+    identify(cardName_, setName_, collectorNumber_);
+  }
+  return result; // Return the processed result
+}
+
+cv::Mat DetectionWorkflow::recognizeCard(const cv::Mat &card) {
   cv::Mat result;
+  if (options_.faceCheck && !checkCardFace(card)) {
+    return card.clone();
+  }
+
+  // Rotate before any region is cut out so OCR only ever runs once
+  cv::Mat upright = options_.orientationCheck ? orientCard(card) : card;
+  if (options_.rarities) {
+    classifyRarity(upright);
+  }
+  if (options_.frameColors) {
+    classifyFrameColor(upright);
+  }
+
   switch (type_) {
   case CardType::modernNormal:
-    result = processModernNormal(imagePath);
-    readTextFromRegions();
-    lookupCardInfo();
+    result = processModernNormal(upright);
+    // A frame too blurry or glared to read is too unreliable to sort too
+    if (options_.binSorter && options_.sortBeforeOcr &&
+        (!options_.qualityGate || quality_.acceptable()) && sortLocally()) {
+      break;
+    }
+    if (hasArtMatch()) {
+      // The art pins the printing; text quality no longer matters unless
+      // its lookup fails
+      break;
+    }
+    readCardText();
     break;
   default:
     throw std::runtime_error("Unsupported card type");
   }
 
-  return result; // Return the processed result
+  return result;
 }
 
-cv::Mat
-DetectionWorkflow::processModernNormal(const std::filesystem::path &imagePath) {
-  // Process the card using the detection pipeline
-  ASSERT(!imagePath.empty(), "Image path is empty");
-  auto card = detect::processCards(imagePath);
+void DetectionWorkflow::readCardText() {
+  if (options_.qualityGate && !quality_.acceptable()) {
+    // OCR and the lookup fallbacks are the slow path; a better frame is
+    // cheaper than reading this one
+    spdlog::warn("Card rejected before OCR: focus {:.1f}, clipped {:.3f}",
+                 quality_.focus, quality_.clippedRatio);
+    status_ = ScanStatus::lowQuality;
+    return;
+  }
+  if (options_.recognitionCache && recallRecognition()) {
+    return;
+  }
+  misc::Stopwatch timer;
+  readTextFromRegions();
+  timings_.ocrMs = timer.lap();
+}
+
+bool DetectionWorkflow::checkCardFace(const cv::Mat &card) {
+  misc::Stopwatch timer;
+  auto decision = faceClassifier_.classify(card);
+  timings_.faceMs = timer.lap();
+
+  switch (decision.face) {
+  case detect::CardFace::back:
+    spdlog::warn("Card is face down, flip needed");
+    status_ = ScanStatus::flipNeeded;
+    return false;
+  case detect::CardFace::notACard:
+    spdlog::warn("Detected quad is not a card");
+    status_ = ScanStatus::notACard;
+    return false;
+  default:
+    return true;
+  }
+}
+
+cv::Mat DetectionWorkflow::orientCard(const cv::Mat &card) {
+  misc::Stopwatch timer;
+  orientation_ = detect::assessOrientation(card, options_.orientation);
+  if (!orientation_.upsideDown) {
+    timings_.orientMs = timer.lap();
+    return card;
+  }
+
+  spdlog::info("Card is upside down, rotating by 180 degrees");
+  cv::Mat upright;
+  cv::rotate(card, upright, cv::ROTATE_180);
+  timings_.orientMs = timer.lap();
+  return upright;
+}
+
+void DetectionWorkflow::classifyFrameColor(const cv::Mat &card) {
+  misc::Stopwatch timer;
+  frameColor_ = options_.frameColors->classify(card);
+  uprightCard_ = card.clone();
+  timings_.colorMs = timer.lap();
+  spdlog::debug("Frame color {} (confidence {:.2f})",
+                detect::frameColorName(frameColor_->color),
+                frameColor_->confidence);
+}
+
+void DetectionWorkflow::classifyRarity(const cv::Mat &card) {
+  misc::Stopwatch timer;
+  // Before tilt correction: the symbol region has margin enough for the
+  // small rotation a warped card can have left
+  symbolImage_ = card(detect::extractSetSymbolRegionModern(card)).clone();
+  rarity_ = options_.rarities->classify(symbolImage_);
+  timings_.rarityMs = timer.lap();
+  spdlog::debug("Set symbol rarity {} (confidence {:.2f})",
+                detect::rarityName(rarity_->rarity), rarity_->confidence);
+}
+
+void DetectionWorkflow::checkRarity() {
+  if (!options_.rarities || !rarity_ || rarity_->confidence <= 0.0) {
+    return;
+  }
+  auto known = detect::parseRarity(cardInfo_->rarity);
+  if (!known) {
+    return; // Special and bonus rarities have no symbol color of their own
+  }
+  rarityAgrees_ = rarity_->rarity == *known;
+  if (!printingConfirmed_) {
+    return; // A name fallback may be another printing of the card
+  }
+  if (!*rarityAgrees_) {
+    if (rarity_->confidence >= options_.maxRarityOverrideConfidence) {
+      spdlog::warn("Set symbol clearly reads {} ({:.2f}), the card is {}; "
+                   "not learned",
+                   detect::rarityName(rarity_->rarity), rarity_->confidence,
+                   cardInfo_->rarity);
+      return;
+    }
+    spdlog::debug("Set symbol read as {}, the card is {}",
+                  detect::rarityName(rarity_->rarity), cardInfo_->rarity);
+  }
+  std::ignore = options_.rarities->learn(symbolImage_, *known);
+}
+
+void DetectionWorkflow::learnFrameColor() {
+  // A name fallback may be another card than the one scanned
+  if (!options_.frameColors || uprightCard_.empty() || !printingConfirmed_) {
+    return;
+  }
+  auto color = cardFeatures(*cardInfo_).color;
+  if (!color) {
+    return;
+  }
+  if (frameColor_ && frameColor_->color != *color) {
+    spdlog::debug("Frame read as {}, the card is {}",
+                  detect::frameColorName(frameColor_->color),
+                  detect::frameColorName(*color));
+  }
+  options_.frameColors->learn(uprightCard_, *color);
+}
+
+bool DetectionWorkflow::sortLocally() {
+  misc::Stopwatch timer;
+  CardFeatures features;
+  if (frameColor_ && frameColor_->confidence >= options_.minColorConfidence) {
+    features.color = frameColor_->color;
+  }
+  if (rarity_ && rarity_->confidence >= options_.minRarityConfidence) {
+    features.rarity = rarity_->rarity;
+  }
+  auto decision = options_.binSorter->assign(features);
+  timings_.sortMs = timer.lap();
+  if (!decision.decided) {
+    return false; // A rule needs the set, type or price
+  }
+
+  spdlog::info("Card sorted without OCR: bin {} ({})", decision.bin,
+               decision.rule);
+  bin_ = std::move(decision);
+  status_ = ScanStatus::sortedLocally;
+  return true;
+}
 
+void DetectionWorkflow::assignBin() {
+  if (!options_.binSorter) {
+    return;
+  }
+  misc::Stopwatch timer;
+  bin_ = options_.binSorter->assign(cardFeatures(*cardInfo_));
+  timings_.sortMs += timer.lap();
+  spdlog::debug("Bin {} ({})", bin_->bin, bin_->rule);
+}
+
+void DetectionWorkflow::resetResults() {
+  textCrop_ = {};
+  nameImage_.release();
+  collectorNumberImage_.release();
+  setNameImage_.release();
+  artImage_.release();
+  symbolImage_.release();
+  uprightCard_.release();
+  keyStripImage_.release();
+  cardName_.clear();
+  collectorNumber_.clear();
+  setName_.clear();
+  cardInfo_.reset();
+  confidence_ = {};
+  nameRead_ = false;
+  dropPendingName();
+  digitsByTemplate_ = false;
+  timings_ = {};
+  quality_ = {};
+  orientation_ = {};
+  frameColor_.reset();
+  rarity_.reset();
+  rarityAgrees_.reset();
+  bin_.reset();
+  artMatches_.clear();
+  artCardId_.clear();
+  fingerprints_.reset();
+  printingConfirmed_ = false;
+  cacheHit_ = false;
+  artIdentified_ = false;
+  status_ = ScanStatus::unidentified;
+  trackSource_ = detect::TrackSource::none;
+}
+
+cv::Mat DetectionWorkflow::processModernNormal(const cv::Mat &warpedCard) {
   // Apply tilt correction
-  card = detect::correctCardTilt(card);
+  misc::Stopwatch timer;
+  auto card = detect::correctCardTilt(warpedCard);
+  timings_.tiltMs = timer.lap();
 
   // Extract bounding boxes
   auto name_box = detect::extractNameRegion(card);
   auto collector_box = detect::extractCollectorNumberRegionModern(card);
   auto set_name_box = detect::extractSetNameRegionModern(card);
   auto art_box = detect::extractArtRegionRegular(card);
+  // The quality gate's thresholds are calibrated on the fixed regions
+  const std::vector<cv::Rect> quality_boxes{name_box, collector_box,
+                                            set_name_box};
+  if (options_.fitTextLines) {
+    auto fit = [this, &card](cv::Rect &box, double &ratio) {
+      auto fitted = detect::fitTextLine(card, box, options_.textLine);
+      if (box.area() > 0) {
+        ratio = static_cast<double>(fitted.area()) / box.area();
+      }
+      box = fitted;
+    };
+    fit(name_box, textCrop_.cardName);
+    fit(collector_box, textCrop_.collectorNumber);
+    fit(set_name_box, textCrop_.setName);
+  }
 
   // Store the extracted regions in member variables
   nameImage_ = card(name_box).clone();
   collectorNumberImage_ = card(collector_box).clone();
   setNameImage_ = card(set_name_box).clone();
   artImage_ = card(art_box).clone();
+  auto key_strip_box = collector_box | set_name_box;
+  keyStripImage_ = card(key_strip_box).clone();
+  keyStripCollectorBox_ = collector_box - key_strip_box.tl();
+  keyStripSetBox_ = set_name_box - key_strip_box.tl();
+  timings_.regionsMs = timer.lap();
+
+  // Score the text regions the OCR will read
+  quality_ = detect::assessQuality(card, quality_boxes, options_.quality);
+  timings_.qualityMs = timer.lap();
+
+  if (options_.artIndex) {
+    matchArt(card);
+    timings_.artMs = timer.lap();
+  }
 
   // Draw all bounding boxes on the card with different colors
   cv::Mat result = card.clone();
@@ -67,33 +471,259 @@ DetectionWorkflow::processModernNormal(const std::filesystem::path &imagePath) {
   return result;
 }
 
+void DetectionWorkflow::matchArt(const cv::Mat &card) {
+  auto hash = detect::computeArtHash(card(detect::artHashRegion(card)));
+  artMatches_ = options_.artIndex->query(hash, options_.maxArtDistance);
+  if (artMatches_.empty()) {
+    spdlog::debug("No art match within {} bits", options_.maxArtDistance);
+    return;
+  }
+
+  // Reprints share art; only a clear winner skips OCR, otherwise the set
+  // code and collector number decide between the printings
+  const auto &best = artMatches_.front();
+  bool unique = artMatches_.size() == 1 ||
+                artMatches_[1].distance - best.distance >=
+                    options_.minArtMargin;
+  if (unique) {
+    artCardId_ = best.id;
+    spdlog::info("Art matches {} at distance {}", best.id, best.distance);
+  } else {
+    spdlog::info("{} printings share this art, confirming with OCR",
+                 artMatches_.size());
+  }
+}
+
+bool DetectionWorkflow::recallRecognition() {
+  misc::Stopwatch timer;
+  fingerprints_ = fingerprintRegions();
+  auto cached = options_.recognitionCache->find(*fingerprints_);
+  timings_.cacheMs = timer.lap();
+  if (!cached) {
+    return false;
+  }
+
+  // Same text regions as a card the lookup already confirmed
+  cardInfo_ = cached->cardInfo;
+  cardName_ = cardInfo_->name;
+  setName_ = cardInfo_->setCode;
+  collectorNumber_ = cardInfo_->collectorNumber;
+  confidence_ = {100, 100, 100};
+  status_ = ScanStatus::identified;
+  printingConfirmed_ = true; // Only confirmed printings are cached
+  cacheHit_ = true;
+  spdlog::info("Recognized {} ({} #{}) from cache", cardName_, setName_,
+               collectorNumber_);
+  assignBin();
+  return true;
+}
+
+RegionFingerprints DetectionWorkflow::fingerprintRegions() const {
+  return RegionFingerprints{detect::fingerprintRegion(nameImage_),
+                            detect::fingerprintRegion(setNameImage_),
+                            detect::fingerprintRegion(collectorNumberImage_)};
+}
+
+void DetectionWorkflow::rememberRecognition() {
+  // A name fallback returns Scryfall's default printing, not necessarily
+  // the scanned one; caching it would hand every later scan of this
+  // printing the wrong set and number
+  if (!options_.recognitionCache || !fingerprints_ || cacheHit_ ||
+      !printingConfirmed_) {
+    return;
+  }
+  options_.recognitionCache->insert(
+      {*fingerprints_, *cardInfo_, timings_.ocrMs + timings_.lookupMs});
+}
+
 void DetectionWorkflow::readTextFromRegions() {
-  // Extract text from each region using OCR
+  // The set code and collector number are the lookup key and the small
+  // regions; the name is the largest region and only a fallback
+  if (options_.ocrPool) {
+    readRegionsConcurrently();
+  } else {
+    readLookupKey();
+  }
+
+  bool key_confident = !setName_.empty() && !collectorNumber_.empty() &&
+                       confidence_.setName >= options_.minKeyConfidence &&
+                       confidence_.collectorNumber >= options_.minKeyConfidence;
+  if (options_.lazyNameOcr && key_confident) {
+    spdlog::debug("Lookup key is confident, name OCR deferred");
+    return;
+  }
+  readCardName();
+}
+
+void DetectionWorkflow::readRegionsConcurrently() {
+  // Every region gets its own pooled Tesseract engine, so latency drops
+  // toward the slowest region. This thread reads the lookup key itself
+  // instead of idling on the futures.
+  auto &pool = *options_.ocrPool;
+  const auto &profile = options_.ocrProfile;
+  std::future<detect::OcrResult> set_code;
   if (!nameImage_.empty()) {
-    cardName_ = detect::extractText(nameImage_);
-    spdlog::info("Extracted card name: {}", cardName_);
+    // With a lazy name this is speculative: it runs while the key resolves
+    // and is only collected if the key or its lookup turns out unsure. A
+    // dropped read that has not started yet is skipped.
+    auto dropped = std::make_shared<std::atomic<bool>>(false);
+    pendingName_ = pool.submit(
+        [image = nameImage_, settings = profile.cardName, dropped] {
+          if (dropped->load()) {
+            return detect::OcrResult{};
+          }
+          return detect::recognizeText(image, settings);
+        });
+    pendingNameDropped_ = std::move(dropped);
+  }
+
+  if (options_.combinedKeyOcr) {
+    // The key is a single pass; only the name can run alongside it
+    readLookupKey();
+  } else {
+    if (!setNameImage_.empty()) {
+      set_code =
+          pool.submit([image = setNameImage_, &settings = profile.setCode] {
+            return detect::recognizeSetCode(image, settings);
+          });
+    }
+    if (!readDigitsByTemplate() && !collectorNumberImage_.empty()) {
+      storeCollectorNumber(detect::recognizeCollectorNumber(
+          collectorNumberImage_, profile.collectorNumber));
+    }
+  }
+
+  // Waiting runs other queued tasks, so this is safe on a pool worker too
+  if (set_code.valid()) {
+    storeSetName(pool.wait(set_code));
+  }
+  if (!options_.lazyNameOcr) {
+    readCardName();
+  }
+}
+
+void DetectionWorkflow::dropPendingName() {
+  if (pendingNameDropped_) {
+    pendingNameDropped_->store(true);
+    pendingNameDropped_.reset();
+  }
+  pendingName_ = {};
+}
+
+void DetectionWorkflow::readLookupKey() {
+  const auto &profile = options_.ocrProfile;
+  if (readDigitsByTemplate()) {
+    // Only the set code is left for Tesseract
+    if (!setNameImage_.empty()) {
+      storeSetName(detect::recognizeSetCode(setNameImage_, profile.setCode));
+    }
+    return;
+  }
+
+  if (options_.combinedKeyOcr && !keyStripImage_.empty()) {
+    auto key = detect::recognizeLookupKey(keyStripImage_, keyStripCollectorBox_,
+                                          keyStripSetBox_, profile);
+    storeCollectorNumber(key.collectorNumber);
+    storeSetName(key.setCode);
+    return;
   }
 
   if (!collectorNumberImage_.empty()) {
     // Use specialized function for digits only
-    collectorNumber_ = detect::extractCollectorNumber(collectorNumberImage_);
-    spdlog::info("Extracted collector number: {}", collectorNumber_);
+    storeCollectorNumber(detect::recognizeCollectorNumber(
+        collectorNumberImage_, profile.collectorNumber));
   }
-
   if (!setNameImage_.empty()) {
     // Use specialized function for set code (uppercase letters)
-    setName_ = detect::extractSetCode(setNameImage_);
-    spdlog::info("Extracted set name: {}", setName_);
+    storeSetName(detect::recognizeSetCode(setNameImage_, profile.setCode));
   }
 }
 
+bool DetectionWorkflow::readDigitsByTemplate() {
+  if (!options_.digitRecognizer || collectorNumberImage_.empty()) {
+    return false;
+  }
+  auto number = options_.digitRecognizer->recognize(collectorNumberImage_);
+  if (number.text.empty() || number.confidence < options_.minDigitConfidence) {
+    spdlog::debug("Digit templates unsure ({}%), using Tesseract",
+                  number.confidence);
+    return false;
+  }
+  storeCollectorNumber(number);
+  digitsByTemplate_ = true;
+  return true;
+}
+
+void DetectionWorkflow::learnDigits() {
+  // Only a set code and collector number lookup that matched the read
+  // labels the glyphs; a name fallback may be another printing
+  if (!printingConfirmed_) {
+    return;
+  }
+  // Glyphs Tesseract had to read are the ones the templates are missing
+  if (options_.digitRecognizer && !digitsByTemplate_ &&
+      !collectorNumberImage_.empty()) {
+    options_.digitRecognizer->learn(collectorNumberImage_,
+                                    cardInfo_->collectorNumber);
+  }
+}
+
+void DetectionWorkflow::readCardName() {
+  if (nameRead_) {
+    return;
+  }
+  if (pendingName_.valid()) {
+    // Started on the pool while the key was read
+    storeCardName(options_.ocrPool->wait(pendingName_));
+    pendingNameDropped_.reset();
+    return;
+  }
+  if (nameImage_.empty()) {
+    return;
+  }
+  storeCardName(
+      detect::recognizeText(nameImage_, options_.ocrProfile.cardName));
+}
+
+void DetectionWorkflow::storeCardName(const detect::OcrResult &name) {
+  cardName_ = name.text;
+  confidence_.cardName = name.confidence;
+  nameRead_ = true;
+  spdlog::info("Extracted card name: {} ({}%)", cardName_, name.confidence);
+}
+
+void DetectionWorkflow::storeCollectorNumber(const detect::OcrResult &number) {
+  collectorNumber_ = number.text;
+  confidence_.collectorNumber = number.confidence;
+  spdlog::info("Extracted collector number: {} ({}%)", collectorNumber_,
+               number.confidence);
+}
+
+void DetectionWorkflow::storeSetName(const detect::OcrResult &setCode) {
+  if (options_.setCodes && !setCode.text.empty()) {
+    auto known = options_.setCodes->correct(setCode);
+    if (known.text != setCode.text) {
+      spdlog::info("Set code read as '{}', taken as '{}'", setCode.text,
+                   known.text);
+    }
+    setName_ = known.text;
+    confidence_.setName = known.confidence;
+  } else {
+    setName_ = setCode.text;
+    confidence_.setName = setCode.confidence;
+  }
+  spdlog::info("Extracted set name: {} ({}%)", setName_, confidence_.setName);
+}
+
 void DetectionWorkflow::lookupCardInfo() {
   // Try to look up card info from Scryfall using collector number + set code
   if (!setName_.empty() && !collectorNumber_.empty()) {
     cardInfo_ =
-        scryfallClient_.getCardByCollectorNumber(setName_, collectorNumber_);
+        scryfallClient_->getCardByCollectorNumber(setName_, collectorNumber_);
 
     if (cardInfo_ && cardInfo_->isValid) {
+      printingConfirmed_ =
+          isReadPrinting(*cardInfo_, setName_, collectorNumber_);
       spdlog::info("=== Card Identified ===");
       spdlog::info("Name: {}", cardInfo_->name);
       spdlog::info("Set: {} ({})", cardInfo_->setName, cardInfo_->setCode);
@@ -107,10 +737,15 @@ void DetectionWorkflow::lookupCardInfo() {
     }
   }
 
-  // Fallback: try fuzzy name search
+  // Fallback: try fuzzy name search, reading the name now if it was deferred
+  if (cardName_.empty()) {
+    misc::Stopwatch timer;
+    readCardName();
+    timings_.ocrMs += timer.lap();
+  }
   if (!cardName_.empty()) {
     spdlog::info("Collector number lookup failed, trying fuzzy name search...");
-    cardInfo_ = scryfallClient_.getCardByFuzzyName(cardName_);
+    cardInfo_ = scryfallClient_->getCardByFuzzyName(cardName_);
 
     if (cardInfo_ && cardInfo_->isValid) {
       spdlog::info("=== Card Identified (by name) ===");
@@ -0,0 +1,105 @@
+#include <card_detector.hpp>
+#include <multi_card_workflow.hpp>
+
+#include <libassert/assert.hpp>
+#include <spdlog/spdlog.h>
+
+#include <future>
+#include <stdexcept>
+#include <utility>
+
+namespace workflow {
+
+MultiCardWorkflow::MultiCardWorkflow(CardType type, WorkflowOptions options,
+                                     std::shared_ptr<misc::ThreadPool> pool)
+    : type_(type), options_(options),
+      scryfallClient_(std::make_shared<api::ScryfallClient>()),
+      pool_(pool ? std::move(pool) : std::make_shared<misc::ThreadPool>()) {
+  // Every card is a separate detection; following corners between them
+  // would be meaningless
+  options_.trackCorners = false;
+  // Cards already run one per core. Region OCR on the same scheduler only
+  // adds tasks to steal, but a second pool would oversubscribe the CPU.
+  if (options_.ocrPool != pool_) {
+    options_.ocrPool.reset();
+  }
+}
+
+std::vector<CardScan>
+MultiCardWorkflow::process(const std::filesystem::path &imagePath) {
+  ASSERT(!imagePath.empty(), "Image path is empty");
+  cv::Mat original_image;
+  cv::Mat undistorted_image;
+  if (!detect::detail::loadImage(imagePath, original_image,
+                                 undistorted_image)) {
+    throw std::runtime_error("Failed to load image");
+  }
+  return process(undistorted_image);
+}
+
+std::vector<CardScan> MultiCardWorkflow::process(const cv::Mat &frame) {
+  auto cards = detect::processAllCards(frame);
+  spdlog::info("Found {} cards in frame", cards.size());
+
+  std::vector<std::future<CardScan>> pending;
+  pending.reserve(cards.size());
+  for (auto &card : cards) {
+    pending.push_back(
+        pool_->submit([this, image = card.image,
+                      corners = std::move(card.corners)]() mutable {
+          return processCard(image, std::move(corners));
+        }));
+  }
+
+  std::vector<CardScan> results;
+  results.reserve(pending.size());
+  for (auto &future : pending) {
+    results.push_back(pool_->wait(future));
+  }
+  return results;
+}
+
+CardScan MultiCardWorkflow::processCard(const cv::Mat &card,
+                                        std::vector<cv::Point2f> corners) {
+  CardScan scan;
+  scan.corners = std::move(corners);
+
+  auto flow = acquireWorkflow();
+  try {
+    scan.annotated = flow->processWarped(card);
+    scan.cardName = flow->getCardName();
+    scan.setName = flow->getSetName();
+    scan.collectorNumber = flow->getCollectorNumber();
+    scan.cardInfo = flow->getCardInfo();
+    scan.status = flow->getStatus();
+    scan.frameColor = flow->getFrameColor();
+    scan.rarity = flow->getRarity();
+    scan.bin = flow->getBin();
+  } catch (const std::exception &e) {
+    scan.error = e.what();
+  }
+  releaseWorkflow(std::move(flow));
+  return scan;
+}
+
+std::unique_ptr<DetectionWorkflow> MultiCardWorkflow::acquireWorkflow() {
+  {
+    std::lock_guard<std::mutex> lock(idleMutex_);
+    if (!idle_.empty()) {
+      auto flow = std::move(idle_.back());
+      idle_.pop_back();
+      return flow;
+    }
+  }
+  // All Scryfall lookups go through one client so they share its cache
+  return std::make_unique<DetectionWorkflow>(type_, options_,
+                                             scryfallClient_);
+}
+
+void MultiCardWorkflow::releaseWorkflow(
+    std::unique_ptr<DetectionWorkflow> flow) {
+  std::lock_guard<std::mutex> lock(idleMutex_);
+  idle_.push_back(std::move(flow));
+}
+
+} // namespace workflow
@@ -0,0 +1,74 @@
+#include <libassert/assert.hpp>
+#include <ocr_voter.hpp>
+
+#include <algorithm>
+
+namespace workflow {
+
+namespace {
+// Tesseract reports 0 for empty output, but a reading of 0 still counts as
+// a frame; keep it from dividing by zero
+constexpr int min_vote_weight = 1;
+
+void vote(std::map<std::string, int> &ballot, const std::string &text,
+          int confidence) {
+  if (text.empty()) {
+    return;
+  }
+  ballot[text] += std::max(confidence, min_vote_weight);
+}
+} // namespace
+
+OcrVoter::OcrVoter(VoteConfig config) : config_(config) {
+  ASSERT(config_.maxFrames > 0, "Frame limit must be positive");
+}
+
+void OcrVoter::add(const std::string &cardName, int cardNameConfidence,
+                   const std::string &setName, int setNameConfidence,
+                   const std::string &collectorNumber,
+                   int collectorNumberConfidence) {
+  vote(cardNames_, cardName, cardNameConfidence);
+  vote(setNames_, setName, setNameConfidence);
+  vote(collectorNumbers_, collectorNumber, collectorNumberConfidence);
+  ++frames_;
+}
+
+FieldVote OcrVoter::leader(const Ballot &ballot) const {
+  FieldVote vote;
+  int total = 0;
+  for (const auto &[text, score] : ballot) {
+    total += score;
+    if (score > vote.score) {
+      vote.text = text;
+      vote.score = score;
+    }
+  }
+  if (total > 0) {
+    vote.agreement = static_cast<double>(vote.score) / total;
+  }
+  vote.confident = vote.score >= config_.acceptScore &&
+                   vote.agreement >= config_.minAgreement;
+  return vote;
+}
+
+bool OcrVoter::isSettled() const {
+  return leader(setNames_).confident && leader(collectorNumbers_).confident;
+}
+
+bool OcrVoter::isDone() const {
+  return isSettled() || frames_ >= config_.maxFrames;
+}
+
+VoteConsensus OcrVoter::consensus() const {
+  return {leader(cardNames_), leader(collectorNumbers_), leader(setNames_),
+          frames_};
+}
+
+void OcrVoter::reset() {
+  cardNames_.clear();
+  setNames_.clear();
+  collectorNumbers_.clear();
+  frames_ = 0;
+}
+
+} // namespace workflow
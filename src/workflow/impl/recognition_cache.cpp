@@ -0,0 +1,102 @@
+#include <recognition_cache.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace workflow {
+
+namespace {
+// Largest region distance, or -1 if any region is too far off
+int matchDistance(const RegionFingerprints &a, const RegionFingerprints &b,
+                  int maxDistance) {
+  int name = detect::hammingDistance(a.cardName, b.cardName);
+  int set = detect::hammingDistance(a.setName, b.setName);
+  int number = detect::hammingDistance(a.collectorNumber, b.collectorNumber);
+  int worst = std::max({name, set, number});
+  return worst <= maxDistance ? worst : -1;
+}
+} // namespace
+
+RecognitionCache::RecognitionCache(CacheConfig config) : config_(config) {}
+
+std::optional<CachedRecognition>
+RecognitionCache::find(const RegionFingerprints &fingerprints) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.lookups;
+
+  auto best = entries_.end();
+  int best_distance = -1;
+  bool ambiguous = false;
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    int distance =
+        matchDistance(fingerprints, it->fingerprints, config_.maxDistance);
+    if (distance < 0) {
+      continue;
+    }
+    if (best != entries_.end() && best->cardInfo.id != it->cardInfo.id) {
+      // Two printings look alike (e.g. a reprint with the same frame); let
+      // OCR decide rather than guess
+      ambiguous = true;
+    }
+    if (best_distance < 0 || distance < best_distance) {
+      best = it;
+      best_distance = distance;
+    }
+  }
+
+  if (best == entries_.end() || ambiguous) {
+    return std::nullopt;
+  }
+
+  ++stats_.hits;
+  stats_.savedMs += best->costMs;
+  entries_.splice(entries_.begin(), entries_, best);
+  return entries_.front();
+}
+
+void RecognitionCache::insert(CachedRecognition entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // A copy that already matches needs no second entry
+  auto known = std::find_if(
+      entries_.begin(), entries_.end(), [&](const CachedRecognition &cached) {
+        return cached.cardInfo.id == entry.cardInfo.id &&
+               matchDistance(cached.fingerprints, entry.fingerprints,
+                             config_.maxDistance) >= 0;
+      });
+  if (known != entries_.end()) {
+    entries_.splice(entries_.begin(), entries_, known);
+    return;
+  }
+
+  entries_.push_front(std::move(entry));
+  if (entries_.size() > config_.capacity) {
+    entries_.pop_back();
+  }
+}
+
+CacheStats RecognitionCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::size_t RecognitionCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void RecognitionCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  stats_ = {};
+}
+
+void logCacheStats(const CacheStats &stats) {
+  spdlog::info("Recognition cache: {}/{} hits ({:.1f}%), {:.0f} ms of OCR "
+               "and lookups saved",
+               stats.hits, stats.lookups, stats.hitRate() * 100.0,
+               stats.savedMs);
+}
+
+} // namespace workflow
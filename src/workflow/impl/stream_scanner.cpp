@@ -0,0 +1,114 @@
+#include <spdlog/spdlog.h>
+#include <stream_scanner.hpp>
+
+#include <stdexcept>
+#include <tuple>
+
+namespace workflow {
+
+StreamScanner::StreamScanner(DetectionWorkflow &flow, VoteConfig config)
+    : flow_(flow), voter_(config) {}
+
+std::optional<ScanResult> StreamScanner::addFrame(const cv::Mat &frame) {
+  ++framesSeen_;
+  if (emitted_) {
+    return std::nullopt; // Already decided; don't spend OCR on this card
+  }
+
+  try {
+    std::ignore = flow_.recognize(frame);
+  } catch (const std::runtime_error &e) {
+    spdlog::debug("Frame not read: {}", e.what());
+    return std::nullopt;
+  }
+  if (flow_.hasArtMatch() && flow_.identifyByArt()) {
+    return emitStatus(); // Identified without OCR; no vote needed
+  }
+  // A failed art lookup fell back to the gate, the cache and OCR
+  if (flow_.getStatus() == ScanStatus::lowQuality) {
+    lowQualitySeen_ = true;
+    return std::nullopt; // Wait for a sharper frame of the same card
+  }
+  if (isRejected(flow_.getStatus())) {
+    // Face down, not a card or sorted locally: more frames won't change
+    // that
+    return emitStatus();
+  }
+  if (flow_.isCacheHit()) {
+    return emitStatus(); // Identified without OCR; no vote needed
+  }
+
+  ++framesRead_;
+  const auto &confidence = flow_.getOcrConfidence();
+  voter_.add(flow_.getCardName(), confidence.cardName, flow_.getSetName(),
+             confidence.setName, flow_.getCollectorNumber(),
+             confidence.collectorNumber);
+
+  if (!voter_.isDone()) {
+    return std::nullopt;
+  }
+  return emit();
+}
+
+std::optional<ScanResult> StreamScanner::endCard() {
+  std::optional<ScanResult> result;
+  if (!emitted_ && voter_.frames() > 0) {
+    result = emit();
+  } else if (!emitted_ && lowQualitySeen_) {
+    // A card was there but no frame was sharp enough to read; it still
+    // needs a result so the sorter does not pass it on undecided
+    result = emitLowQuality();
+  }
+
+  voter_.reset();
+  emitted_ = false;
+  lowQualitySeen_ = false;
+  framesSeen_ = 0;
+  flow_.resetTracking();
+  return result;
+}
+
+ScanResult StreamScanner::emitStatus() {
+  ScanResult result;
+  result.cardInfo = flow_.getCardInfo();
+  result.status = flow_.getStatus();
+  result.frameColor = flow_.getFrameColor();
+  result.rarity = flow_.getRarity();
+  result.bin = flow_.getBin();
+  result.framesSeen = framesSeen_;
+
+  emitted_ = true;
+  ++cardsEmitted_;
+  return result;
+}
+
+ScanResult StreamScanner::emitLowQuality() {
+  ScanResult result;
+  result.status = ScanStatus::lowQuality;
+  result.framesSeen = framesSeen_;
+
+  emitted_ = true;
+  ++cardsEmitted_;
+  return result;
+}
+
+ScanResult StreamScanner::emit() {
+  ScanResult result;
+  result.consensus = voter_.consensus();
+  result.framesSeen = framesSeen_;
+
+  const auto &consensus = result.consensus;
+  flow_.identify(consensus.cardName.text, consensus.setName.text,
+                 consensus.collectorNumber.text);
+  result.cardInfo = flow_.getCardInfo();
+  result.status = flow_.getStatus();
+  result.frameColor = flow_.getFrameColor();
+  result.rarity = flow_.getRarity();
+  result.bin = flow_.getBin();
+
+  emitted_ = true;
+  ++cardsEmitted_;
+  return result;
+}
+
+} // namespace workflow
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <frame_color.hpp>
+#include <rarity.hpp>
+#include <scryfall_client.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace workflow {
+
+// What is known about a card when its bin is chosen. Before OCR only the
+// frame color and the rarity are; after the lookup everything is.
+struct CardFeatures {
+  std::string setCode; // Lowercase; empty if unknown
+  std::optional<detect::Rarity> rarity;
+  std::optional<detect::FrameColor> color;
+  std::optional<std::string> typeLine;
+  std::optional<double> priceUsd;
+  // From the lookup: a missing value is absent from the card, not unread,
+  // so predicates on it fail instead of waiting for OCR
+  bool complete{false};
+};
+
+// Features of an identified card. Its colors map onto the frame classes:
+// one color is that color, several are multicolor, none are land (if the
+// type line says so) or artifact. A card without a USD price (0) has no
+// price, so neither min_usd nor max_usd rules take it.
+[[nodiscard]] CardFeatures cardFeatures(const api::CardInfo &card);
+
+struct BinDecision {
+  // False if a rule that could still fire needs a feature that is not
+  // known yet; the card has to be read and looked up first
+  bool decided{false};
+  int bin{0};
+  std::string rule; // Name of the rule that fired; "default" if none did
+};
+
+inline constexpr int max_bins = 64;
+
+// A bin configuration compiled for evaluation. Predicate values are
+// interned when the rules are parsed, so a card's set code and type line
+// are looked up once and every rule is then matched with integer compares
+// and bit masks. Rules are tried in order; the first whose predicates all
+// hold and whose bin is not full decides. Cards no rule takes go to the
+// default bin, which is never considered full.
+class BinRules {
+public:
+  // JSON with a "name", a "default_bin" and a "rules" array. Each rule has
+  // a "name", a "bin" and any of the predicates "set", "rarity", "color"
+  // and "type" (lists; one entry must match) and "min_usd" and "max_usd".
+  // Throws std::runtime_error if the file cannot be read or holds an
+  // unknown key, rarity or color, a type of more than one word, or a bin
+  // outside 0-63.
+  [[nodiscard]] static BinRules load(const std::filesystem::path &path);
+  [[nodiscard]] static BinRules parse(const std::string &json);
+
+  [[nodiscard]] BinDecision evaluate(const CardFeatures &card,
+                                     std::uint64_t fullBins = 0) const;
+
+  [[nodiscard]] const std::string &name() const { return name_; }
+  [[nodiscard]] std::size_t size() const { return rules_.size(); }
+
+private:
+  struct Rule {
+    std::string name;
+    int bin{0};
+    std::vector<int> sets;     // Sorted set code ids; empty matches any
+    std::uint32_t rarities{0}; // Bit per detect::Rarity; 0 matches any
+    std::uint32_t colors{0};   // Bit per detect::FrameColor; 0 matches any
+    std::uint64_t types{0};    // Bit per type word; 0 matches any
+    std::optional<double> minUsd;
+    std::optional<double> maxUsd;
+  };
+
+  enum class Match { no, yes, unknown };
+
+  [[nodiscard]] static Match match(const Rule &rule, const CardFeatures &card,
+                                   std::optional<int> setId,
+                                   std::uint64_t cardTypes);
+  [[nodiscard]] std::uint64_t typeMask(const std::string &typeLine) const;
+  [[nodiscard]] int internType(const std::string &type);
+
+  std::string name_;
+  int defaultBin_{0};
+  std::vector<Rule> rules_;
+  std::unordered_map<std::string, int> setIds_;  // Lowercase set code
+  std::unordered_map<std::string, int> typeIds_; // Lowercase type word
+};
+
+// Assigns bins with the current rules. The rules can be replaced while
+// other threads assign; nobody waits for the swap. Bin fullness comes from
+// the sorting machine and survives rule swaps. Safe to share between
+// workflows on different threads.
+class BinSorter {
+public:
+  explicit BinSorter(BinRules rules);
+
+  [[nodiscard]] BinDecision assign(const CardFeatures &card) const;
+
+  // Later assign() calls use the new rules; calls already running finish
+  // with the old ones
+  void setRules(BinRules rules);
+  [[nodiscard]] std::shared_ptr<const BinRules> rules() const;
+
+  // A full bin's rules are skipped until it is emptied
+  void setBinFull(int bin, bool full);
+  [[nodiscard]] bool isBinFull(int bin) const;
+
+private:
+  std::shared_ptr<const BinRules> rules_; // Only via std::atomic_load/store
+  std::atomic<std::uint64_t> fullBins_{0};
+};
+
+} // namespace workflow
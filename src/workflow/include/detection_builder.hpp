@@ -1,10 +1,29 @@
 #pragma once
 
+#include <art_index.hpp>
+#include <bin_rules.hpp>
+#include <card_face.hpp>
+#include <card_orientation.hpp>
+#include <card_text_ocr.hpp>
+#include <card_tracker.hpp>
+#include <digit_recognizer.hpp>
+#include <frame_color.hpp>
+#include <image_quality.hpp>
+#include <ocr_profile.hpp>
 #include <opencv2/opencv.hpp>
+#include <rarity.hpp>
+#include <recognition_cache.hpp>
+#include <region_extraction.hpp>
 #include <scryfall_client.hpp>
+#include <set_code_dictionary.hpp>
+#include <thread_pool.hpp>
 
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace workflow {
 
@@ -13,45 +32,325 @@ enum class CardType {
   // Can be extended with more card types in the future
 };
 
+// Wall-clock time spent in each pipeline stage for the last processed card
+struct StageTimings {
+  double detectMs{0.0};  // Load, detect and warp
+  double faceMs{0.0};    // Card back / non-card check
+  double orientMs{0.0};  // Upside-down check and rotation
+  double colorMs{0.0};   // Frame color classification
+  double rarityMs{0.0};  // Set symbol rarity classification
+  double tiltMs{0.0};    // Tilt correction
+  double regionsMs{0.0}; // Region extraction
+  double qualityMs{0.0}; // Focus and glare check
+  double artMs{0.0};     // Art hash and index search
+  double cacheMs{0.0};   // Region fingerprints and cache search
+  double ocrMs{0.0};     // Text extraction (including a deferred name)
+  double lookupMs{0.0};  // Scryfall lookup (including cache)
+  double sortMs{0.0};    // Bin rule evaluation
+
+  [[nodiscard]] double totalMs() const {
+    return detectMs + faceMs + orientMs + colorMs + rarityMs + tiltMs +
+           regionsMs + qualityMs + artMs + cacheMs + ocrMs + lookupMs +
+           sortMs;
+  }
+};
+
+// Outcome of the last processed card
+enum class ScanStatus {
+  identified,   // Lookup returned a card
+  unidentified, // OCR ran but the lookup found nothing
+  lowQuality,   // Rejected before OCR; retry with a new frame
+  flipNeeded,   // Card lies face down
+  notACard,     // Detected quad is not a card
+  sortedLocally // Bin decided from frame color and rarity alone
+};
+
+// Statuses where OCR and the lookup were skipped
+[[nodiscard]] inline bool isRejected(ScanStatus status) {
+  return status == ScanStatus::lowQuality ||
+         status == ScanStatus::flipNeeded || status == ScanStatus::notACard ||
+         status == ScanStatus::sortedLocally;
+}
+
+// Tesseract confidence (0-100) of each extracted text field
+struct OcrConfidence {
+  int cardName{0};
+  int collectorNumber{0};
+  int setName{0};
+};
+
+// Fraction of each fixed text region's pixels that OCR reads after the
+// region is fitted to its text line (1 = not cropped)
+struct TextCropRatios {
+  double cardName{1.0};
+  double collectorNumber{1.0};
+  double setName{1.0};
+};
+
+struct WorkflowOptions {
+  bool qualityGate{true}; // Skip OCR and lookup for blurry or glared cards
+  detect::QualityConfig quality;
+  bool faceCheck{true}; // Skip OCR and lookup for card backs and blanks
+  detect::FaceConfig face;
+  cv::Mat cardBackTemplate; // Optional; replaces the built-in color check
+  bool orientationCheck{true}; // Rotate upside-down cards before extraction
+  detect::OrientationConfig orientation;
+  // Classifies every card face by its frame color; may be shared between
+  // workflows. Null skips the check.
+  std::shared_ptr<detect::FrameColorClassifier> frameColors;
+  // Classifies every card's rarity from its set symbol and learns from
+  // identified cards; may be shared between workflows. Null skips it.
+  std::shared_ptr<detect::RarityClassifier> rarities;
+  // A symbol read at least this confident that disagrees with the lookup is
+  // logged instead of learned: the lookup is more likely the wrong printing
+  double maxRarityOverrideConfidence{0.6};
+  // Assigns every card a bin; may be shared between workflows. Null assigns
+  // no bins.
+  std::shared_ptr<BinSorter> binSorter;
+  // If the rules can decide from the frame color and rarity alone, skip OCR
+  // and the lookup. Off by default: an untrained classifier's mistakes go
+  // unchecked. Cards the quality gate rejects are never sorted locally.
+  bool sortBeforeOcr{false};
+  // Local reads less confident than this are unknown to the bin rules
+  double minColorConfidence{0.5};
+  double minRarityConfidence{0.5};
+  // Read the name only if the set code and collector number are unsure or
+  // their lookup fails; both need this Tesseract confidence (0-100)
+  bool lazyNameOcr{true};
+  int minKeyConfidence{80};
+  // Model, engine and preprocessing of each text field
+  detect::OcrProfile ocrProfile;
+  // Crop each text region to its text line before OCR
+  bool fitTextLines{true};
+  detect::TextLineConfig textLine;
+  // Read the set code and collector number in one pass over the info block
+  // they share, instead of preprocessing and recognizing each on its own.
+  // Ignored for profiles whose two key fields use different engines. Off by
+  // default: the collector number is upscaled like the set code, which can
+  // change its read.
+  bool combinedKeyOcr{false};
+  // Reads collector numbers by glyph templates and learns the printed font
+  // from identified cards; Tesseract only reads what it is unsure of. May
+  // be shared between workflows. Null always uses Tesseract.
+  std::shared_ptr<detect::DigitRecognizer> digitRecognizer;
+  int minDigitConfidence{85};
+  // Known set codes; a read is corrected to the likeliest one or dropped,
+  // so impossible codes never reach Scryfall. Null keeps the raw read.
+  std::shared_ptr<const detect::SetCodeDictionary> setCodes;
+  // Reads the text regions concurrently; null reads them one after another.
+  // Usually the application's scheduler, which OpenCV also runs on. With a
+  // lazy name, the name is read speculatively alongside the key and dropped
+  // if the key identifies the card.
+  std::shared_ptr<misc::ThreadPool> ocrPool;
+  // Reference art hashes; a unique match identifies the card without OCR
+  std::shared_ptr<const detect::ArtIndex> artIndex;
+  int maxArtDistance{16}; // Hamming bits (of 128) still counted as a match
+  int minArtMargin{8};    // Best match must beat the next printing by this
+  // Identified cards by region fingerprint; may be shared between
+  // workflows. A hit skips OCR and the lookup.
+  std::shared_ptr<RecognitionCache> recognitionCache;
+  bool trackCorners{false}; // Follow the card across process(frame) calls
+  detect::TrackerConfig tracker;
+};
+
 class DetectionWorkflow {
 public:
-  explicit DetectionWorkflow(CardType type);
+  // The Scryfall client may be shared between workflows running on
+  // different threads; a private one is created if none is given
+  explicit DetectionWorkflow(
+      CardType type, WorkflowOptions options = {},
+      std::shared_ptr<api::ScryfallClient> scryfallClient = nullptr);
 
   // Build and process the card image
   cv::Mat process(const std::filesystem::path &imagePath);
 
+  // Process a card from an already loaded frame (e.g. a camera frame)
+  cv::Mat process(const cv::Mat &frame);
+
+  // Process a card that is already detected and warped
+  cv::Mat processWarped(const cv::Mat &card);
+
+  // Detect, warp and read a frame without the Scryfall lookup
+  cv::Mat recognize(const cv::Mat &frame);
+
+  // Look up a card from text fields (e.g. a multi-frame consensus)
+  void identify(const std::string &cardName, const std::string &setName,
+                const std::string &collectorNumber);
+
+  // Look up the printing the art index matched. If the lookup fails, the
+  // already extracted regions go through the quality gate, the recognition
+  // cache and OCR as if there had been no match; returns true on success.
+  bool identifyByArt();
+
+  // Forget the tracked card so the next frame runs full detection
+  void resetTracking() { tracker_.reset(); }
+
   // Accessors for extracted text (from OCR)
   [[nodiscard]] const std::string &getCardName() const { return cardName_; }
   [[nodiscard]] const std::string &getCollectorNumber() const {
     return collectorNumber_;
   }
   [[nodiscard]] const std::string &getSetName() const { return setName_; }
+  [[nodiscard]] const OcrConfidence &getOcrConfidence() const {
+    return confidence_;
+  }
 
   // Accessor for enriched card info (from Scryfall)
   [[nodiscard]] const std::optional<api::CardInfo> &getCardInfo() const {
     return cardInfo_;
   }
 
+  // Per-stage timings of the last process() call
+  [[nodiscard]] const StageTimings &getTimings() const { return timings_; }
+
+  // Quality scores and outcome of the last process() call
+  [[nodiscard]] const detect::QualityScores &getQuality() const {
+    return quality_;
+  }
+  [[nodiscard]] ScanStatus getStatus() const { return status_; }
+
+  // Share of each text region OCR read in the last process() call
+  [[nodiscard]] const TextCropRatios &getTextCrop() const { return textCrop_; }
+
+  // Frame color of the last card; empty without a classifier or if the
+  // card was rejected before the check
+  [[nodiscard]] const std::optional<detect::FrameColorDecision> &
+  getFrameColor() const {
+    return frameColor_;
+  }
+
+  // Set symbol rarity of the last card; empty without a classifier or if
+  // the card was rejected before the check
+  [[nodiscard]] const std::optional<detect::RarityDecision> &
+  getRarity() const {
+    return rarity_;
+  }
+
+  // Whether the symbol rarity matched the identified card's; empty until
+  // a card with a classified symbol is identified
+  [[nodiscard]] std::optional<bool> rarityAgrees() const {
+    return rarityAgrees_;
+  }
+
+  // Bin of the last card and the rule that chose it; empty without a
+  // sorter, for rejected cards and for cards the lookup did not identify
+  [[nodiscard]] const std::optional<BinDecision> &getBin() const {
+    return bin_;
+  }
+
+  // Upside-down check of the last process() call
+  [[nodiscard]] const detect::OrientationScores &getOrientation() const {
+    return orientation_;
+  }
+
+  // Art index matches of the last card, nearest first. hasArtMatch() is
+  // true if one printing stood out and OCR was skipped.
+  [[nodiscard]] const std::vector<detect::ArtMatch> &getArtMatches() const {
+    return artMatches_;
+  }
+  [[nodiscard]] bool hasArtMatch() const { return !artCardId_.empty(); }
+
+  // The name region of the last card went through OCR
+  [[nodiscard]] bool wasNameRead() const { return nameRead_; }
+
+  // The collector number of the last card was read by digit templates
+  [[nodiscard]] bool usedDigitTemplates() const { return digitsByTemplate_; }
+
+  // The last card was recalled from the recognition cache
+  [[nodiscard]] bool isCacheHit() const { return cacheHit_; }
+
+  // The last card was identified by its art; its text fields are
+  // Scryfall's, not OCR reads
+  [[nodiscard]] bool isArtIdentified() const { return artIdentified_; }
+
+  // How the card was located in the last process(frame) call
+  [[nodiscard]] detect::TrackSource getTrackSource() const {
+    return trackSource_;
+  }
+
 private:
   CardType type_;
+  WorkflowOptions options_;
 
   // Extracted region images
   cv::Mat nameImage_;
   cv::Mat collectorNumberImage_;
   cv::Mat setNameImage_;
   cv::Mat artImage_;
+  cv::Mat symbolImage_; // Set symbol, kept to learn the confirmed rarity
+  cv::Mat uprightCard_; // Whole card, kept to learn the confirmed color
+  // Bottom-left info block holding both key fields, and their boxes in it
+  cv::Mat keyStripImage_;
+  cv::Rect keyStripCollectorBox_;
+  cv::Rect keyStripSetBox_;
 
   // Extracted text from regions
   std::string cardName_;
   std::string collectorNumber_;
   std::string setName_;
+  OcrConfidence confidence_;
+  bool nameRead_{false};
+  // Speculative name read on the ocrPool while the key resolves, and the
+  // flag that skips it if it is dropped before it starts
+  std::future<detect::OcrResult> pendingName_;
+  std::shared_ptr<std::atomic<bool>> pendingNameDropped_;
+  bool digitsByTemplate_{false}; // Collector number read without Tesseract
 
   // Enriched card info from Scryfall
   std::optional<api::CardInfo> cardInfo_;
-  api::ScryfallClient scryfallClient_;
+  std::shared_ptr<api::ScryfallClient> scryfallClient_;
+
+  StageTimings timings_;
+  TextCropRatios textCrop_;
+  detect::QualityScores quality_;
+  detect::CardFaceClassifier faceClassifier_;
+  detect::OrientationScores orientation_;
+  std::optional<detect::FrameColorDecision> frameColor_;
+  std::optional<detect::RarityDecision> rarity_;
+  std::optional<bool> rarityAgrees_;
+  std::optional<BinDecision> bin_;
+  std::vector<detect::ArtMatch> artMatches_;
+  std::string artCardId_; // Scryfall ID of a unique art match
+  std::optional<RegionFingerprints> fingerprints_; // Of the last OCR'd card
+  // The identified printing is the scanned one: its set code and collector
+  // number matched the read, or its art did. False after a name fallback.
+  bool printingConfirmed_{false};
+  bool cacheHit_{false};
+  bool artIdentified_{false};
+  ScanStatus status_{ScanStatus::unidentified};
+
+  detect::CardTracker tracker_;
+  detect::TrackSource trackSource_{detect::TrackSource::none};
 
-  cv::Mat processModernNormal(const std::filesystem::path &imagePath);
+  void resetResults();
+  cv::Mat locateCard(const cv::Mat &frame);
+  cv::Mat processCard(const cv::Mat &card);
+  cv::Mat recognizeCard(const cv::Mat &card);
+  // Quality gate, recognition cache, then OCR of the extracted regions
+  void readCardText();
+  bool checkCardFace(const cv::Mat &card);
+  cv::Mat orientCard(const cv::Mat &card);
+  void classifyFrameColor(const cv::Mat &card);
+  void classifyRarity(const cv::Mat &card);
+  void checkRarity();
+  void learnFrameColor();
+  bool sortLocally();
+  void assignBin();
+  cv::Mat processModernNormal(const cv::Mat &warpedCard);
+  void matchArt(const cv::Mat &card);
+  bool recallRecognition();
+  [[nodiscard]] RegionFingerprints fingerprintRegions() const;
+  void rememberRecognition();
   void readTextFromRegions();
+  void readRegionsConcurrently();
+  void readLookupKey();
+  [[nodiscard]] bool readDigitsByTemplate();
+  void learnDigits();
+  void readCardName();
+  void dropPendingName();
+  void storeCardName(const detect::OcrResult &name);
+  void storeCollectorNumber(const detect::OcrResult &number);
+  void storeSetName(const detect::OcrResult &setCode);
   void lookupCardInfo();
 };
 } // namespace workflow
\ No newline at end of file
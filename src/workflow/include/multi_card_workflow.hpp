@@ -0,0 +1,66 @@
+#pragma once
+
+#include <detection_builder.hpp>
+#include <scryfall_client.hpp>
+#include <thread_pool.hpp>
+
+#include <opencv2/opencv.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace workflow {
+
+// Result for one card of a multi-card frame
+struct CardScan {
+  std::vector<cv::Point2f> corners; // TL, TR, BR, BL in the frame
+  cv::Mat annotated;                // Warped card with region boxes
+  std::string cardName;
+  std::string setName;
+  std::string collectorNumber;
+  std::optional<api::CardInfo> cardInfo;
+  ScanStatus status{ScanStatus::unidentified};
+  std::optional<detect::FrameColorDecision> frameColor;
+  std::optional<detect::RarityDecision> rarity;
+  std::optional<BinDecision> bin;
+  std::string error; // Non-empty if processing this card threw
+};
+
+// Processes every card in a frame (e.g. a binder page). Cards are detected
+// in one pass over the frame, then tilt correction, OCR and lookup run for
+// all of them concurrently on a thread pool.
+class MultiCardWorkflow {
+public:
+  // Cards run on the given pool (usually the application's scheduler); a
+  // null pool means a private one with one worker per hardware thread
+  explicit MultiCardWorkflow(CardType type, WorkflowOptions options = {},
+                             std::shared_ptr<misc::ThreadPool> pool = nullptr);
+
+  // Results are in reading order (rows top to bottom, left to right)
+  [[nodiscard]] std::vector<CardScan>
+  process(const std::filesystem::path &imagePath);
+  [[nodiscard]] std::vector<CardScan> process(const cv::Mat &frame);
+
+private:
+  [[nodiscard]] CardScan processCard(const cv::Mat &card,
+                                     std::vector<cv::Point2f> corners);
+  [[nodiscard]] std::unique_ptr<DetectionWorkflow> acquireWorkflow();
+  void releaseWorkflow(std::unique_ptr<DetectionWorkflow> flow);
+
+  CardType type_;
+  WorkflowOptions options_;
+  std::shared_ptr<api::ScryfallClient> scryfallClient_;
+
+  // Workflows are stateful, so each task borrows one from this free list
+  std::mutex idleMutex_;
+  std::vector<std::unique_ptr<DetectionWorkflow>> idle_;
+
+  // Last: a private pool's workers must stop before the rest goes
+  std::shared_ptr<misc::ThreadPool> pool_;
+};
+
+} // namespace workflow
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace workflow {
+
+// When a multi-frame reading counts as settled
+struct VoteConfig {
+  int acceptScore{85};      // Summed confidence the leading reading needs
+  double minAgreement{0.6}; // Leading reading's share of all confidence
+  int maxFrames{5};         // Give up and use the best guess after this many
+};
+
+// Leading reading of one field
+struct FieldVote {
+  std::string text;
+  int score{0};          // Summed confidence of this reading
+  double agreement{0.0}; // score / confidence of all readings
+  bool confident{false};
+};
+
+struct VoteConsensus {
+  FieldVote cardName;
+  FieldVote collectorNumber;
+  FieldVote setName;
+  int frames{0};
+};
+
+// Accumulates OCR readings of one physical card over several frames and
+// votes per field, weighting each reading by its Tesseract confidence. A
+// single confident frame settles immediately; uncertain or conflicting
+// frames need more support.
+class OcrVoter {
+public:
+  explicit OcrVoter(VoteConfig config = {});
+
+  // Add the readings of one frame; confidences are 0-100
+  void add(const std::string &cardName, int cardNameConfidence,
+           const std::string &setName, int setNameConfidence,
+           const std::string &collectorNumber, int collectorNumberConfidence);
+
+  // Set code and collector number (the lookup key) are both confident
+  [[nodiscard]] bool isSettled() const;
+
+  // No more frames are worth reading for this card
+  [[nodiscard]] bool isDone() const;
+
+  [[nodiscard]] VoteConsensus consensus() const;
+  [[nodiscard]] int frames() const { return frames_; }
+
+  void reset();
+
+private:
+  using Ballot = std::map<std::string, int>; // Reading -> summed confidence
+
+  [[nodiscard]] FieldVote leader(const Ballot &ballot) const;
+
+  VoteConfig config_;
+  Ballot cardNames_;
+  Ballot setNames_;
+  Ballot collectorNumbers_;
+  int frames_{0};
+};
+
+} // namespace workflow
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <region_fingerprint.hpp>
+#include <scryfall_client.hpp>
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+
+namespace workflow {
+
+// Fingerprints of the three text regions OCR would read
+struct RegionFingerprints {
+  detect::RegionFingerprint cardName;
+  detect::RegionFingerprint setName;
+  detect::RegionFingerprint collectorNumber;
+};
+
+struct CacheConfig {
+  std::size_t capacity{512}; // Printings remembered, least recently used out
+  int maxDistance{40};       // Per region, of 512 bits
+};
+
+// A card the lookup confirmed, and what reading it cost
+struct CachedRecognition {
+  RegionFingerprints fingerprints;
+  api::CardInfo cardInfo;
+  double costMs{0.0}; // OCR and lookup time each hit saves
+};
+
+struct CacheStats {
+  std::size_t lookups{0};
+  std::size_t hits{0};
+  double savedMs{0.0};
+
+  [[nodiscard]] double hitRate() const {
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+  }
+};
+
+// Remembers identified cards by the look of their text regions, so the
+// dozens of copies of the same common in a bulk box are read by OCR once.
+// Only lookups that returned a card are stored, and a hit needs every
+// region to be a near-duplicate of a single printing. Safe to share between
+// workflows on different threads.
+class RecognitionCache {
+public:
+  explicit RecognitionCache(CacheConfig config = {});
+
+  // The remembered card if the regions match exactly one printing
+  [[nodiscard]] std::optional<CachedRecognition>
+  find(const RegionFingerprints &fingerprints);
+
+  void insert(CachedRecognition entry);
+
+  [[nodiscard]] CacheStats stats() const;
+  [[nodiscard]] std::size_t size() const;
+  void clear();
+
+private:
+  CacheConfig config_;
+  mutable std::mutex mutex_; // Guards entries_ and stats_
+  std::list<CachedRecognition> entries_; // Most recently used first
+  CacheStats stats_;
+};
+
+// One log line with hit rate and saved time
+void logCacheStats(const CacheStats &stats);
+
+} // namespace workflow
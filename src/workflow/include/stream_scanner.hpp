@@ -0,0 +1,63 @@
+#pragma once
+
+#include <detection_builder.hpp>
+#include <ocr_voter.hpp>
+
+#include <opencv2/opencv.hpp>
+#include <scryfall_client.hpp>
+
+#include <cstddef>
+#include <optional>
+
+namespace workflow {
+
+// One physical card, read over one or more frames
+struct ScanResult {
+  VoteConsensus consensus;
+  std::optional<api::CardInfo> cardInfo;
+  ScanStatus status{ScanStatus::unidentified};
+  // Of the frame that decided the card (the last one read for a vote)
+  std::optional<detect::FrameColorDecision> frameColor;
+  std::optional<detect::RarityDecision> rarity;
+  std::optional<BinDecision> bin;
+  int framesSeen{0}; // Frames fed for this card, including unread ones
+};
+
+// Turns a stream of frames into one result per card. Each frame of the
+// current card is read until the OCR vote settles (or the frame limit is
+// reached); the lookup then runs once on the consensus and later frames of
+// the same card are ignored until endCard(). A unique art match or a
+// recognition cache hit decides the card on its first frame.
+class StreamScanner {
+public:
+  explicit StreamScanner(DetectionWorkflow &flow, VoteConfig config = {});
+
+  // Feed a frame of the current card; returns the result once it is decided
+  [[nodiscard]] std::optional<ScanResult> addFrame(const cv::Mat &frame);
+
+  // The current card left or a new one arrived. Returns the best guess if
+  // the card was read but not yet decided, and a lowQuality result if it
+  // was detected but never sharp enough to read.
+  [[nodiscard]] std::optional<ScanResult> endCard();
+
+  // OCR passes run and cards emitted since construction
+  [[nodiscard]] std::size_t framesRead() const { return framesRead_; }
+  [[nodiscard]] std::size_t cardsEmitted() const { return cardsEmitted_; }
+
+private:
+  [[nodiscard]] ScanResult emit();
+  // Decided without a vote (rejected, sorted locally, or identified by
+  // art or cache)
+  [[nodiscard]] ScanResult emitStatus();
+  [[nodiscard]] ScanResult emitLowQuality();
+
+  DetectionWorkflow &flow_;
+  OcrVoter voter_;
+  bool emitted_{false};        // Result for the current card already returned
+  bool lowQualitySeen_{false}; // Card detected but rejected by the gate
+  int framesSeen_{0};
+  std::size_t framesRead_{0};
+  std::size_t cardsEmitted_{0};
+};
+
+} // namespace workflow
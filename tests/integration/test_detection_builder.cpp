@@ -4,6 +4,9 @@
 #include <opencv2/opencv.hpp>
 #include <path_helper.hpp>
 #include <pic_helper.hpp>
+#include <thread_pool.hpp>
+
+#include <memory>
 
 class DetectionWorkflowTest : public ::testing::Test {
 protected:
@@ -72,4 +75,52 @@ TEST_F(DetectionWorkflowTest, UnsupportedCardType) {
       *std::filesystem::directory_iterator(misc::getSamplesPath());
   EXPECT_THROW(unsupported_builder.process(sample_file.path()),
                std::runtime_error);
-}
\ No newline at end of file
+}
+
+// Reading the regions concurrently must not change what is read
+TEST_F(DetectionWorkflowTest, ParallelOcrMatchesSequential) {
+  workflow::WorkflowOptions options;
+  options.lazyNameOcr = false;
+  workflow::DetectionWorkflow sequential(workflow::CardType::modernNormal,
+                                         options);
+  options.ocrPool = std::make_shared<misc::ThreadPool>(2);
+  workflow::DetectionWorkflow parallel(workflow::CardType::modernNormal,
+                                       options);
+
+  for (const auto &entry :
+       std::filesystem::directory_iterator(misc::getSamplesPath())) {
+    sequential.process(entry.path());
+    parallel.process(entry.path());
+    EXPECT_EQ(parallel.getCardName(), sequential.getCardName())
+        << entry.path();
+    EXPECT_EQ(parallel.getSetName(), sequential.getSetName()) << entry.path();
+    EXPECT_EQ(parallel.getCollectorNumber(), sequential.getCollectorNumber())
+        << entry.path();
+  }
+}
+
+// The single pass over the info block reads what the separate crops read
+TEST_F(DetectionWorkflowTest, CombinedKeyOcrMatchesSplit) {
+  workflow::WorkflowOptions options;
+  options.combinedKeyOcr = false;
+  workflow::DetectionWorkflow split(workflow::CardType::modernNormal, options);
+  options.combinedKeyOcr = true;
+  workflow::DetectionWorkflow combined(workflow::CardType::modernNormal,
+                                       options);
+
+  int cards = 0;
+  int agreeing = 0;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(misc::getSamplesPath())) {
+    split.process(entry.path());
+    combined.process(entry.path());
+    ++cards;
+    if (combined.getSetName() == split.getSetName() &&
+        combined.getCollectorNumber() == split.getCollectorNumber()) {
+      ++agreeing;
+    }
+  }
+  // Both fields are preprocessed at the set code's scale, which may change
+  // a digit on a poor sample; the pass stays opt-in until they all agree
+  EXPECT_GE(agreeing * 10, cards * 8);
+}
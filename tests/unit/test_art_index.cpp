@@ -0,0 +1,148 @@
+#include <art_index.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Test fixture for art hashing and the BK-tree index
+class ArtIndexTest : public ::testing::Test {
+protected:
+  // Random color blocks stand in for card art; the seed picks the artwork
+  static cv::Mat createArt(int seed) {
+    cv::RNG rng(seed);
+    cv::Mat art(240, 360, CV_8UC3, cv::Scalar(128, 128, 128));
+    for (int i = 0; i < 12; ++i) {
+      cv::Point corner(rng.uniform(0, 300), rng.uniform(0, 200));
+      cv::Size size(rng.uniform(30, 150), rng.uniform(30, 120));
+      cv::rectangle(art, cv::Rect(corner, size),
+                    cv::Scalar(rng.uniform(0, 256), rng.uniform(0, 256),
+                               rng.uniform(0, 256)),
+                    cv::FILLED);
+    }
+    return art;
+  }
+
+  static detect::ArtHash randomHash(std::mt19937_64 &rng) {
+    return {rng(), rng()};
+  }
+};
+
+// ============== Hash Tests ==============
+
+TEST_F(ArtIndexTest, IdenticalArtHasDistanceZero) {
+  auto art = createArt(1);
+  EXPECT_EQ(detect::hammingDistance(detect::computeArtHash(art),
+                                    detect::computeArtHash(art.clone())),
+            0);
+}
+
+TEST_F(ArtIndexTest, PhotometricChangesKeepHashClose) {
+  auto art = createArt(2);
+  cv::Mat photo;
+  cv::GaussianBlur(art, photo, cv::Size(5, 5), 0);
+  photo.convertTo(photo, -1, 0.8, 20); // Dimmer, lower contrast
+  cv::resize(photo, photo, cv::Size(), 0.5, 0.5, cv::INTER_AREA);
+
+  EXPECT_LE(detect::hammingDistance(detect::computeArtHash(art),
+                                    detect::computeArtHash(photo)),
+            16);
+}
+
+TEST_F(ArtIndexTest, DifferentArtIsFarApart) {
+  EXPECT_GT(detect::hammingDistance(detect::computeArtHash(createArt(3)),
+                                    detect::computeArtHash(createArt(4))),
+            30);
+}
+
+TEST_F(ArtIndexTest, HexRoundTrip) {
+  detect::ArtHash hash{0x0123456789abcdefULL, 0xfedcba9876543210ULL};
+  EXPECT_EQ(detect::toHex(hash), "0123456789abcdeffedcba9876543210");
+  EXPECT_EQ(detect::artHashFromHex(detect::toHex(hash)), hash);
+  EXPECT_THROW(std::ignore = detect::artHashFromHex("12"),
+               std::invalid_argument);
+}
+
+// ============== Index Tests ==============
+
+TEST_F(ArtIndexTest, QueryMatchesBruteForce) {
+  std::mt19937_64 rng(7);
+  std::vector<detect::ArtHash> hashes;
+  detect::ArtIndex index;
+  for (int i = 0; i < 500; ++i) {
+    hashes.push_back(randomHash(rng));
+    index.add(std::to_string(i), hashes.back());
+  }
+
+  // Probe near an indexed hash so there is something to find
+  auto probe = hashes[42];
+  probe.dHash ^= 0x5ULL;
+  const int max_distance = 50;
+
+  std::size_t expected = 0;
+  for (const auto &hash : hashes) {
+    if (detect::hammingDistance(hash, probe) <= max_distance) {
+      ++expected;
+    }
+  }
+
+  auto matches = index.query(probe, max_distance);
+  ASSERT_EQ(matches.size(), expected);
+  EXPECT_EQ(matches.front().id, "42");
+  EXPECT_EQ(matches.front().distance, 2);
+  for (std::size_t i = 1; i < matches.size(); ++i) {
+    EXPECT_LE(matches[i - 1].distance, matches[i].distance);
+  }
+}
+
+TEST_F(ArtIndexTest, ReprintsWithSameArtAreAllReturned) {
+  detect::ArtIndex index;
+  auto hash = detect::computeArtHash(createArt(5));
+  index.add("original", hash);
+  index.add("reprint", hash);
+  index.add("other", detect::computeArtHash(createArt(6)));
+
+  auto matches = index.query(hash, 10);
+  ASSERT_EQ(matches.size(), 2u);
+  EXPECT_EQ(matches[0].distance, 0);
+  EXPECT_EQ(matches[1].distance, 0);
+}
+
+TEST_F(ArtIndexTest, SaveAndLoadRoundTrip) {
+  std::mt19937_64 rng(11);
+  detect::ArtIndex index;
+  for (int i = 0; i < 20; ++i) {
+    index.add("card-" + std::to_string(i), randomHash(rng));
+  }
+  auto probe = randomHash(rng);
+
+  auto path = std::filesystem::temp_directory_path() / "art_index_test.txt";
+  index.save(path);
+  auto loaded = detect::ArtIndex::load(path);
+  std::filesystem::remove(path);
+
+  ASSERT_EQ(loaded.size(), index.size());
+  auto expected = index.query(probe, 128);
+  auto actual = loaded.query(probe, 128);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_EQ(actual[i].id, expected[i].id);
+    EXPECT_EQ(actual[i].distance, expected[i].distance);
+  }
+}
+
+TEST_F(ArtIndexTest, LoadRejectsMalformedFile) {
+  auto path = std::filesystem::temp_directory_path() / "art_index_bad.txt";
+  {
+    std::ofstream file(path);
+    file << "card-1 nothex\n";
+  }
+  EXPECT_THROW(std::ignore = detect::ArtIndex::load(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
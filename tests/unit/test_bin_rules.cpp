@@ -0,0 +1,179 @@
+#include <bin_rules.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+// Test fixture for the bin rule engine
+class BinRulesTest : public ::testing::Test {
+protected:
+  static constexpr const char *rules_json = R"({
+    "name": "test",
+    "default_bin": 9,
+    "rules": [
+      {"name": "mythics", "bin": 1, "rarity": "mythic"},
+      {"name": "blue commons", "bin": 2, "color": "blue",
+       "rarity": ["common"]},
+      {"name": "expensive", "bin": 3, "min_usd": 5.0},
+      {"name": "duskmourn creatures", "bin": 4, "set": ["DSK", "dsc"],
+       "type": "Creature"}
+    ]
+  })";
+
+  static api::CardInfo identifiedCard() {
+    api::CardInfo card;
+    card.name = "Arcane Signet";
+    card.setCode = "DSC";
+    card.rarity = "common";
+    card.typeLine = "Artifact";
+    card.priceUsd = 0.5;
+    card.isValid = true;
+    return card;
+  }
+};
+
+// ============== Evaluation Tests ==============
+
+TEST_F(BinRulesTest, FirstMatchingRuleFires) {
+  auto rules = workflow::BinRules::parse(rules_json);
+  auto card = identifiedCard();
+  card.rarity = "mythic";
+  card.priceUsd = 20.0;
+
+  auto decision = rules.evaluate(workflow::cardFeatures(card));
+
+  EXPECT_TRUE(decision.decided);
+  EXPECT_EQ(decision.bin, 1);
+  EXPECT_EQ(decision.rule, "mythics");
+}
+
+TEST_F(BinRulesTest, TypeWordsAndSetCodesMatchAnyCase) {
+  auto rules = workflow::BinRules::parse(rules_json);
+  auto card = identifiedCard();
+  card.typeLine = "Legendary Creature \xE2\x80\x94 Human Wizard";
+
+  auto decision = rules.evaluate(workflow::cardFeatures(card));
+
+  EXPECT_EQ(decision.rule, "duskmourn creatures");
+}
+
+TEST_F(BinRulesTest, UnmatchedCardGoesToTheDefaultBin) {
+  auto rules = workflow::BinRules::parse(rules_json);
+
+  auto decision = rules.evaluate(workflow::cardFeatures(identifiedCard()));
+
+  EXPECT_TRUE(decision.decided);
+  EXPECT_EQ(decision.bin, 9);
+  EXPECT_EQ(decision.rule, "default");
+}
+
+TEST_F(BinRulesTest, FullBinFallsThroughToTheNextRule) {
+  auto rules = workflow::BinRules::parse(rules_json);
+  auto card = identifiedCard();
+  card.rarity = "mythic";
+  card.priceUsd = 20.0;
+
+  auto decision =
+      rules.evaluate(workflow::cardFeatures(card), std::uint64_t{1} << 1);
+
+  EXPECT_EQ(decision.rule, "expensive");
+}
+
+// ============== Local Decision Tests ==============
+
+TEST_F(BinRulesTest, ColorAndRarityDecideWithoutALookup) {
+  auto rules = workflow::BinRules::parse(rules_json);
+  workflow::CardFeatures local;
+  local.rarity = detect::Rarity::mythic;
+
+  auto decision = rules.evaluate(local);
+
+  EXPECT_TRUE(decision.decided);
+  EXPECT_EQ(decision.bin, 1);
+}
+
+TEST_F(BinRulesTest, RuleOnAnUnreadFeatureWaitsForTheLookup) {
+  auto rules = workflow::BinRules::parse(rules_json);
+  // Not mythic and not a blue common, but the price rule could still fire
+  workflow::CardFeatures local;
+  local.rarity = detect::Rarity::rare;
+  local.color = detect::FrameColor::blue;
+
+  EXPECT_FALSE(rules.evaluate(local).decided);
+}
+
+TEST_F(BinRulesTest, MissingFeatureOfAnIdentifiedCardFails) {
+  auto rules = workflow::BinRules::parse(rules_json);
+  auto card = identifiedCard();
+  card.rarity = "special"; // No symbol color; the rarity rules cannot match
+
+  auto decision = rules.evaluate(workflow::cardFeatures(card));
+
+  EXPECT_TRUE(decision.decided);
+  EXPECT_EQ(decision.rule, "default");
+}
+
+TEST_F(BinRulesTest, CardColorsMapOntoFrameColors) {
+  auto card = identifiedCard();
+  EXPECT_EQ(workflow::cardFeatures(card).color, detect::FrameColor::artifact);
+  card.typeLine = "Land";
+  EXPECT_EQ(workflow::cardFeatures(card).color, detect::FrameColor::land);
+  card.colors = "U";
+  EXPECT_EQ(workflow::cardFeatures(card).color, detect::FrameColor::blue);
+  card.colors = "WU";
+  EXPECT_EQ(workflow::cardFeatures(card).color,
+            detect::FrameColor::multicolor);
+}
+
+TEST_F(BinRulesTest, UnpricedCardMatchesNoPriceRule) {
+  auto rules = workflow::BinRules::parse(R"({
+    "default_bin": 9,
+    "rules": [
+      {"name": "bulk", "bin": 1, "max_usd": 0.5},
+      {"name": "expensive", "bin": 2, "min_usd": 5.0}
+    ]
+  })");
+  auto card = identifiedCard();
+  card.priceUsd = 0.0; // Foil-only or promo: Scryfall lists no USD price
+
+  EXPECT_FALSE(workflow::cardFeatures(card).priceUsd.has_value());
+  auto decision = rules.evaluate(workflow::cardFeatures(card));
+  EXPECT_TRUE(decision.decided);
+  EXPECT_EQ(decision.rule, "default");
+}
+
+// ============== Parsing Tests ==============
+
+TEST_F(BinRulesTest, InvalidRulesAreRejected) {
+  EXPECT_THROW(
+      std::ignore = workflow::BinRules::parse(R"({"rules": [{"bin": 64}]})"),
+      std::runtime_error);
+  EXPECT_THROW(std::ignore = workflow::BinRules::parse(
+                   R"({"rules": [{"bin": 1, "rarity": "legendary"}]})"),
+               std::runtime_error);
+  EXPECT_THROW(std::ignore = workflow::BinRules::parse(
+                   R"({"rules": [{"bin": 1, "colour": "blue"}]})"),
+               std::runtime_error);
+  EXPECT_THROW(std::ignore = workflow::BinRules::parse(
+                   R"({"rules": [{"name": "no bin", "set": "dsc"}]})"),
+               std::runtime_error);
+}
+
+// ============== Sorter Tests ==============
+
+TEST_F(BinRulesTest, SorterSwapsRulesAndKeepsFullness) {
+  workflow::BinSorter sorter(workflow::BinRules::parse(rules_json));
+  sorter.setBinFull(9, true);
+  auto old_rules = sorter.rules();
+
+  sorter.setRules(workflow::BinRules::parse(R"({"default_bin": 5})"));
+  auto decision = sorter.assign(workflow::cardFeatures(identifiedCard()));
+
+  EXPECT_EQ(decision.bin, 5);
+  EXPECT_TRUE(sorter.isBinFull(9));
+  // A caller holding the old rules can still finish with them
+  EXPECT_EQ(old_rules->name(), "test");
+  sorter.setBinFull(9, false);
+  EXPECT_FALSE(sorter.isBinFull(9));
+}
@@ -0,0 +1,86 @@
+#include <card_face.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+// Test fixture for the card-back / non-card classifier
+class CardFaceTest : public ::testing::Test {
+protected:
+  // Brown frame around a blue oval, like the Magic card back
+  static cv::Mat createBack() {
+    cv::Mat card(680, 480, CV_8UC3, cv::Scalar(30, 70, 120)); // Brown
+    cv::ellipse(card, cv::Point(240, 340), cv::Size(170, 260), 0, 0, 360,
+                cv::Scalar(120, 50, 20), cv::FILLED); // Dark blue
+    cv::putText(card, "Deckmaster", cv::Point(150, 80),
+                cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(40, 200, 230), 2);
+    return card;
+  }
+
+  // Black border, light frame, text box and a colorful art block
+  static cv::Mat createFront() {
+    cv::Mat card(680, 480, CV_8UC3, cv::Scalar(20, 20, 20));
+    cv::rectangle(card, cv::Rect(20, 20, 440, 640), cv::Scalar(190, 200, 210),
+                  cv::FILLED);
+    cv::rectangle(card, cv::Rect(50, 90, 380, 260), cv::Scalar(60, 140, 90),
+                  cv::FILLED);
+    cv::putText(card, "Queen Marchesa", cv::Point(30, 60),
+                cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(10, 10, 10), 2);
+    return card;
+  }
+};
+
+// ============== Color Signature Tests ==============
+
+TEST_F(CardFaceTest, BackIsRecognizedByColor) {
+  detect::CardFaceClassifier classifier;
+  EXPECT_EQ(classifier.classify(createBack()).face, detect::CardFace::back);
+}
+
+TEST_F(CardFaceTest, FrontIsNotABack) {
+  detect::CardFaceClassifier classifier;
+  EXPECT_EQ(classifier.classify(createFront()).face, detect::CardFace::front);
+}
+
+TEST_F(CardFaceTest, BlankQuadIsNotACard) {
+  detect::CardFaceClassifier classifier;
+  cv::Mat blank(680, 480, CV_8UC3, cv::Scalar(128, 128, 128));
+
+  auto decision = classifier.classify(blank);
+
+  EXPECT_EQ(decision.face, detect::CardFace::notACard);
+  EXPECT_LT(decision.stddev, 1.0);
+}
+
+// ============== Template Tests ==============
+
+TEST_F(CardFaceTest, TemplateCorrelationDetectsBack) {
+  detect::CardFaceClassifier classifier;
+  // Template from a differently sized scan of the back
+  cv::Mat scan;
+  cv::resize(createBack(), scan, cv::Size(745, 1040));
+  classifier.setBackTemplate(scan);
+  ASSERT_TRUE(classifier.hasBackTemplate());
+
+  // Slightly darker photo of the back
+  cv::Mat photo = createBack() * 0.8;
+  auto decision = classifier.classify(photo);
+
+  EXPECT_EQ(decision.face, detect::CardFace::back);
+  EXPECT_GT(decision.correlation, 0.9);
+}
+
+TEST_F(CardFaceTest, TemplateCorrelationKeepsFronts) {
+  detect::CardFaceClassifier classifier;
+  classifier.setBackTemplate(createBack());
+
+  auto decision = classifier.classify(createFront());
+
+  EXPECT_EQ(decision.face, detect::CardFace::front);
+  EXPECT_LT(decision.correlation, 0.7);
+}
+
+TEST_F(CardFaceTest, UpsideDownBackIsStillABack) {
+  detect::CardFaceClassifier classifier;
+  cv::Mat rotated;
+  cv::rotate(createBack(), rotated, cv::ROTATE_180);
+  EXPECT_EQ(classifier.classify(rotated).face, detect::CardFace::back);
+}
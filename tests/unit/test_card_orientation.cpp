@@ -0,0 +1,53 @@
+#include <card_orientation.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+// Test fixture for the upside-down check
+class CardOrientationTest : public ::testing::Test {
+protected:
+  // Light name bar with large text on top, dark info strip with small text
+  // at the bottom
+  static cv::Mat createUpright() {
+    cv::Mat card(680, 480, CV_8UC3, cv::Scalar(20, 20, 20));
+    cv::rectangle(card, cv::Rect(20, 20, 440, 570), cv::Scalar(190, 200, 210),
+                  cv::FILLED);
+    cv::putText(card, "Queen Marchesa", cv::Point(30, 58),
+                cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(10, 10, 10), 2);
+    cv::putText(card, "078/249 R CN2", cv::Point(30, 640),
+                cv::FONT_HERSHEY_SIMPLEX, 0.4, cv::Scalar(230, 230, 230), 1);
+    return card;
+  }
+
+  static cv::Mat rotated(const cv::Mat &card) {
+    cv::Mat result;
+    cv::rotate(card, result, cv::ROTATE_180);
+    return result;
+  }
+};
+
+// ============== Orientation Tests ==============
+
+TEST_F(CardOrientationTest, UprightCardIsKept) {
+  auto scores = detect::assessOrientation(createUpright());
+  EXPECT_FALSE(scores.upsideDown);
+  EXPECT_GT(scores.topBrightness, scores.bottomBrightness);
+  EXPECT_GT(scores.topInk, scores.bottomInk);
+}
+
+TEST_F(CardOrientationTest, RotatedCardIsUpsideDown) {
+  auto scores = detect::assessOrientation(rotated(createUpright()));
+  EXPECT_TRUE(scores.upsideDown);
+}
+
+TEST_F(CardOrientationTest, FlatCardIsLeftAlone) {
+  cv::Mat card(680, 480, CV_8UC3, cv::Scalar(128, 128, 128));
+  EXPECT_FALSE(detect::assessOrientation(card).upsideDown);
+}
+
+TEST_F(CardOrientationTest, BrightnessAloneDoesNotFlip) {
+  // Light band at the bottom but no text anywhere: the signals disagree
+  cv::Mat card(680, 480, CV_8UC3, cv::Scalar(20, 20, 20));
+  cv::rectangle(card, cv::Rect(0, 600, 480, 80), cv::Scalar(200, 200, 200),
+                cv::FILLED);
+  EXPECT_FALSE(detect::assessOrientation(card).upsideDown);
+}
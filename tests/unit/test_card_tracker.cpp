@@ -0,0 +1,135 @@
+#include <card_tracker.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+// Test fixture for frame-to-frame card tracking
+class CardTrackerTest : public ::testing::Test {
+protected:
+  static constexpr int cardWidth = 240;
+  static constexpr int cardHeight = 336;
+  static constexpr float cornerTolerance = 5.0F;
+
+  // Grey background with a bordered card whose top-left is at origin
+  static cv::Mat createFrame(cv::Point origin) {
+    cv::Mat frame = createEmptyFrame();
+    cv::Rect card(origin, cv::Size(cardWidth, cardHeight));
+    cv::rectangle(frame, card, cv::Scalar(230, 230, 230), cv::FILLED);
+    cv::rectangle(frame, card, cv::Scalar(15, 15, 15), 12);
+    cv::putText(frame, "Card", origin + cv::Point(30, 60),
+                cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(20, 20, 20), 2);
+    return frame;
+  }
+
+  static cv::Mat createEmptyFrame() {
+    cv::Mat frame(480, 640, CV_8UC3, cv::Scalar(140, 140, 140));
+    cv::Mat noise(frame.size(), CV_8UC3);
+    cv::RNG rng(3);
+    rng.fill(noise, cv::RNG::NORMAL, 0, 4);
+    frame += noise;
+    return frame;
+  }
+
+  static void expectCornersNear(const std::vector<cv::Point2f> &corners,
+                                cv::Point origin) {
+    const std::vector<cv::Point2f> expected = {
+        cv::Point2f(origin),
+        cv::Point2f(origin + cv::Point(cardWidth, 0)),
+        cv::Point2f(origin + cv::Point(cardWidth, cardHeight)),
+        cv::Point2f(origin + cv::Point(0, cardHeight))};
+    ASSERT_EQ(corners.size(), 4u);
+    for (std::size_t i = 0; i < corners.size(); ++i) {
+      EXPECT_NEAR(corners[i].x, expected[i].x, cornerTolerance) << i;
+      EXPECT_NEAR(corners[i].y, expected[i].y, cornerTolerance) << i;
+    }
+  }
+};
+
+// ============== Fallback Order Tests ==============
+
+TEST_F(CardTrackerTest, FirstFrameUsesFullDetection) {
+  detect::CardTracker tracker;
+  auto result = tracker.track(createFrame(cv::Point(200, 72)));
+
+  ASSERT_TRUE(result.found());
+  EXPECT_EQ(result.source, detect::TrackSource::full);
+  EXPECT_EQ(result.card.cols, 480);
+  EXPECT_EQ(result.card.rows, 680);
+  expectCornersNear(result.corners, cv::Point(200, 72));
+  EXPECT_TRUE(tracker.isTracking());
+}
+
+TEST_F(CardTrackerTest, SmallShiftIsFollowedByFlow) {
+  detect::CardTracker tracker;
+  auto first = tracker.track(createFrame(cv::Point(200, 72)));
+  ASSERT_TRUE(first.found());
+
+  auto second = tracker.track(createFrame(cv::Point(203, 74)));
+
+  ASSERT_TRUE(second.found());
+  EXPECT_EQ(second.source, detect::TrackSource::flow);
+  for (std::size_t i = 0; i < first.corners.size(); ++i) {
+    auto moved = second.corners[i] - first.corners[i];
+    EXPECT_NEAR(moved.x, 3.0F, 1.0F) << i;
+    EXPECT_NEAR(moved.y, 2.0F, 1.0F) << i;
+  }
+}
+
+TEST_F(CardTrackerTest, LargeJumpFallsBackToDetection) {
+  detect::CardTracker tracker;
+  ASSERT_TRUE(tracker.track(createFrame(cv::Point(60, 72))).found());
+
+  auto result = tracker.track(createFrame(cv::Point(340, 72)));
+
+  ASSERT_TRUE(result.found());
+  EXPECT_NE(result.source, detect::TrackSource::flow);
+  expectCornersNear(result.corners, cv::Point(340, 72));
+}
+
+TEST_F(CardTrackerTest, RefreshIntervalForcesRegionSearch) {
+  detect::TrackerConfig config;
+  config.refreshInterval = 2;
+  detect::CardTracker tracker(config);
+  cv::Mat frame = createFrame(cv::Point(200, 72));
+
+  EXPECT_EQ(tracker.track(frame).source, detect::TrackSource::full);
+  EXPECT_EQ(tracker.track(frame).source, detect::TrackSource::flow);
+  EXPECT_EQ(tracker.track(frame).source, detect::TrackSource::roi);
+  EXPECT_EQ(tracker.track(frame).source, detect::TrackSource::flow);
+}
+
+// ============== Track Loss Tests ==============
+
+TEST_F(CardTrackerTest, EmptyFrameDropsTrack) {
+  detect::CardTracker tracker;
+  ASSERT_TRUE(tracker.track(createFrame(cv::Point(200, 72))).found());
+
+  auto result = tracker.track(createEmptyFrame());
+
+  EXPECT_FALSE(result.found());
+  EXPECT_TRUE(result.card.empty());
+  EXPECT_FALSE(tracker.isTracking());
+}
+
+TEST_F(CardTrackerTest, ResetStartsWithFullDetection) {
+  detect::CardTracker tracker;
+  cv::Mat frame = createFrame(cv::Point(200, 72));
+  ASSERT_TRUE(tracker.track(frame).found());
+
+  tracker.reset();
+
+  EXPECT_FALSE(tracker.isTracking());
+  EXPECT_EQ(tracker.track(frame).source, detect::TrackSource::full);
+}
+
+TEST_F(CardTrackerTest, ResolutionChangeDropsTrack) {
+  detect::CardTracker tracker;
+  ASSERT_TRUE(tracker.track(createFrame(cv::Point(340, 72))).found());
+
+  cv::Mat smaller;
+  cv::resize(createFrame(cv::Point(340, 72)), smaller, cv::Size(320, 240));
+
+  // The old search region lies outside the smaller frame
+  EXPECT_NE(tracker.track(smaller).source, detect::TrackSource::flow);
+}
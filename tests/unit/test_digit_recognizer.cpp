@@ -0,0 +1,93 @@
+#include <digit_recognizer.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+#include <string>
+
+// Test fixture for the template digit recognizer
+class DigitRecognizerTest : public ::testing::Test {
+protected:
+  // Collector number strip at warped card scale
+  static cv::Mat createStrip(const std::string &text, bool lightText = true) {
+    cv::Scalar background = lightText ? cv::Scalar(20, 20, 20)
+                                      : cv::Scalar(225, 225, 225);
+    cv::Scalar ink = lightText ? cv::Scalar(235, 235, 235)
+                               : cv::Scalar(15, 15, 15);
+    cv::Mat strip(28, 96, CV_8UC3, background);
+    cv::putText(strip, text, cv::Point(6, 21), cv::FONT_HERSHEY_SIMPLEX, 0.65,
+                ink, 2);
+    return strip;
+  }
+
+  // Light strip with a digit-height blob no template matches (a solid
+  // block) after the text, gap pixels to its right
+  static cv::Mat createStripWithBlock(const std::string &text, int gap) {
+    cv::Mat strip = createStrip(text);
+    int baseline = 0;
+    auto size =
+        cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, 0.65, 2, &baseline);
+    cv::rectangle(strip, cv::Rect(6 + size.width + gap, 6, 10, 15),
+                  cv::Scalar(235, 235, 235), cv::FILLED);
+    return strip;
+  }
+
+  detect::DigitRecognizer recognizer;
+};
+
+// ============== Recognition Tests ==============
+
+TEST_F(DigitRecognizerTest, ReadsRenderedDigits) {
+  auto result = recognizer.recognize(createStrip("123"));
+  EXPECT_EQ(result.text, "123");
+  EXPECT_GT(result.confidence, 0);
+}
+
+TEST_F(DigitRecognizerTest, ReadsDarkTextOnLight) {
+  EXPECT_EQ(recognizer.recognize(createStrip("42", false)).text, "42");
+}
+
+TEST_F(DigitRecognizerTest, DropsLeadingZerosLikeTesseractPath) {
+  EXPECT_EQ(recognizer.recognize(createStrip("0092")).text, "92");
+}
+
+TEST_F(DigitRecognizerTest, BlankStripReadsNothing) {
+  auto result = recognizer.recognize(createStrip(""));
+  EXPECT_TRUE(result.text.empty());
+  EXPECT_EQ(result.confidence, 0);
+}
+
+TEST_F(DigitRecognizerTest, UnmatchedGlyphInTheNumberIsUnreadable) {
+  // Dropping it would read "12" for a longer number and skip Tesseract
+  auto result = recognizer.recognize(createStripWithBlock("12", 2));
+  EXPECT_EQ(result.confidence, 0);
+}
+
+TEST_F(DigitRecognizerTest, LetterAfterAGapEndsTheNumber) {
+  auto result = recognizer.recognize(createStripWithBlock("12", 30));
+  EXPECT_EQ(result.text, "12");
+  EXPECT_GT(result.confidence, 0);
+}
+
+// ============== Learning Tests ==============
+
+TEST_F(DigitRecognizerTest, LearnsConfirmedGlyphs) {
+  EXPECT_TRUE(recognizer.learn(createStrip("0789"), "789"));
+  EXPECT_EQ(recognizer.learnedCount(), 4u);
+  EXPECT_EQ(recognizer.recognize(createStrip("0789")).text, "789");
+}
+
+TEST_F(DigitRecognizerTest, RejectsNumbersThatDoNotLineUp) {
+  EXPECT_FALSE(recognizer.learn(createStrip("0789"), "12345"));
+  EXPECT_FALSE(recognizer.learn(createStrip("0789"), "7a9"));
+  EXPECT_EQ(recognizer.learnedCount(), 0u);
+}
+
+TEST_F(DigitRecognizerTest, LearnedTemplatesAreBounded) {
+  detect::DigitRecognizerConfig config;
+  config.maxLearnedPerDigit = 2;
+  detect::DigitRecognizer bounded(config);
+  for (int i = 0; i < 5; ++i) {
+    bounded.learn(createStrip("111"), "111");
+  }
+  EXPECT_EQ(bounded.learnedCount(), 2u);
+}
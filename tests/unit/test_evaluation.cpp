@@ -0,0 +1,181 @@
+#include <evaluation.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+// Test fixture for evaluation scoring
+class EvaluationTest : public ::testing::Test {
+protected:
+  static bench::SampleLabel queenMarchesa() {
+    return {"cn2", "78", "queen marchesa", {}};
+  }
+
+  static bench::EvalRecord perfectRecord() {
+    bench::EvalRecord record;
+    record.file = "cn2-78-queen-marchesa.jpg";
+    record.expected = queenMarchesa();
+    record.name = "Queen Marchesa";
+    record.setCode = "CN2";
+    record.collectorNumber = "78";
+    record.identified = true;
+    record.identifiedName = "Queen Marchesa";
+    record.identifiedSetCode = "cn2";
+    record.identifiedCollectorNumber = "78";
+    record.stageMs = {{"ocr", 100.0}, {"detect", 20.0}};
+    return record;
+  }
+};
+
+TEST_F(EvaluationTest, MatchingIgnoresCaseAndLeadingZeros) {
+  EXPECT_TRUE(bench::nameMatches("queen marchesa", "Queen Marchesa"));
+  EXPECT_FALSE(bench::nameMatches("queen marchesa", "Queen Marches"));
+  EXPECT_FALSE(bench::nameMatches("", ""));
+  EXPECT_TRUE(bench::collectorNumberMatches("78", "078"));
+  EXPECT_FALSE(bench::collectorNumberMatches("78", ""));
+}
+
+TEST_F(EvaluationTest, PerfectRecordScoresFullAccuracy) {
+  auto summary = bench::summarize({perfectRecord()}, 500.0);
+
+  EXPECT_EQ(summary.images, 1u);
+  EXPECT_EQ(summary.failures, 0u);
+  EXPECT_DOUBLE_EQ(summary.name.rate(), 1.0);
+  EXPECT_DOUBLE_EQ(summary.setCode.rate(), 1.0);
+  EXPECT_DOUBLE_EQ(summary.collectorNumber.rate(), 1.0);
+  EXPECT_DOUBLE_EQ(summary.identification.rate(), 1.0);
+  EXPECT_DOUBLE_EQ(summary.cardsPerSecond, 2.0);
+}
+
+TEST_F(EvaluationTest, WrongPrintingIsNotIdentified) {
+  auto record = perfectRecord();
+  record.identifiedSetCode = "cns";
+  record.collectorNumber = "79";
+
+  auto summary = bench::summarize({record, perfectRecord()}, 1000.0);
+
+  EXPECT_DOUBLE_EQ(summary.collectorNumber.rate(), 0.5);
+  EXPECT_EQ(summary.identification.correct, 1u);
+  EXPECT_EQ(summary.identification.total, 2u);
+}
+
+TEST_F(EvaluationTest, FailuresAreCountedAgainstAccuracy) {
+  bench::EvalRecord failed;
+  failed.expected = queenMarchesa();
+  failed.error = "no cards detected";
+
+  auto summary = bench::summarize({failed, perfectRecord()}, 1000.0);
+
+  EXPECT_EQ(summary.failures, 1u);
+  EXPECT_DOUBLE_EQ(summary.name.rate(), 0.5);
+  EXPECT_DOUBLE_EQ(summary.identification.rate(), 0.5);
+}
+
+TEST_F(EvaluationTest, StageStatisticsAggregateAllRecords) {
+  auto slow = perfectRecord();
+  slow.stageMs["ocr"] = 300.0;
+
+  auto summary = bench::summarize({perfectRecord(), slow}, 1000.0);
+
+  ASSERT_EQ(summary.stages.count("ocr"), 1u);
+  EXPECT_DOUBLE_EQ(summary.stages.at("ocr").meanMs, 200.0);
+  EXPECT_DOUBLE_EQ(summary.stages.at("ocr").p50Ms, 100.0);
+  EXPECT_DOUBLE_EQ(summary.stages.at("ocr").p95Ms, 300.0);
+}
+
+TEST_F(EvaluationTest, JsonReportContainsSummaryAndRecords) {
+  std::vector<bench::EvalRecord> records{perfectRecord()};
+  auto summary = bench::summarize(records, 250.0);
+  auto json = bench::toJson(summary, records, "baseline");
+
+  EXPECT_NE(json.find("\"tag\": \"baseline\""), std::string::npos);
+  EXPECT_NE(json.find("\"cards_per_second\""), std::string::npos);
+  EXPECT_NE(json.find("cn2-78-queen-marchesa.jpg"), std::string::npos);
+}
+
+TEST_F(EvaluationTest, QualityRejectionsAreCounted) {
+  auto rejected = perfectRecord();
+  rejected.rejected = true;
+  rejected.identified = false;
+
+  auto summary = bench::summarize({rejected, perfectRecord()}, 1000.0);
+
+  EXPECT_EQ(summary.rejected, 1u);
+  EXPECT_DOUBLE_EQ(summary.identification.rate(), 0.5);
+}
+
+TEST_F(EvaluationTest, SkippedNamesAreNotScored) {
+  auto skipped = perfectRecord();
+  skipped.name.clear();
+  skipped.nameSkipped = true;
+
+  auto summary = bench::summarize({skipped, perfectRecord()}, 1000.0);
+
+  EXPECT_EQ(summary.namesSkipped, 1u);
+  EXPECT_EQ(summary.name.total, 1u);
+  EXPECT_DOUBLE_EQ(summary.name.rate(), 1.0);
+  EXPECT_DOUBLE_EQ(summary.identification.rate(), 1.0);
+}
+
+TEST_F(EvaluationTest, CacheAndArtHitsAreNotScoredAsOcr) {
+  auto cached = perfectRecord();
+  cached.cacheHit = true;
+  auto by_art = perfectRecord();
+  by_art.artIdentified = true;
+  auto misread = perfectRecord();
+  misread.setCode = "XXX";
+
+  auto summary = bench::summarize({cached, by_art, misread}, 1000.0);
+
+  EXPECT_EQ(summary.cacheHits, 1u);
+  EXPECT_EQ(summary.artIdentified, 1u);
+  EXPECT_EQ(summary.setCode.total, 1u);
+  EXPECT_DOUBLE_EQ(summary.setCode.rate(), 0.0);
+  EXPECT_EQ(summary.name.total, 1u);
+  EXPECT_DOUBLE_EQ(summary.identification.rate(), 1.0);
+  auto json = bench::toJson(summary, {by_art}, "");
+  EXPECT_NE(json.find("\"art_identified\": 1"), std::string::npos);
+}
+
+TEST_F(EvaluationTest, TextCropIsAveragedPerRegion) {
+  auto tight = perfectRecord();
+  tight.textCrop = {{"name", 0.2}, {"set_code", 0.5}};
+  auto loose = perfectRecord();
+  loose.textCrop = {{"name", 0.4}};
+  // Records without regions (e.g. rejected cards) do not count
+  auto summary = bench::summarize({tight, loose, perfectRecord()}, 1000.0);
+
+  EXPECT_DOUBLE_EQ(summary.textCrop.at("name"), 0.3);
+  EXPECT_DOUBLE_EQ(summary.textCrop.at("set_code"), 0.5);
+  auto json = bench::toJson(summary, {tight}, "");
+  EXPECT_NE(json.find("\"text_crop\""), std::string::npos);
+}
+
+TEST_F(EvaluationTest, SymbolRarityIsScoredAgainstTheIdentifiedCard) {
+  auto agrees = perfectRecord();
+  agrees.identifiedRarity = "rare";
+  agrees.rarity = "rare";
+  auto differs = perfectRecord();
+  differs.identifiedRarity = "mythic";
+  differs.rarity = "rare";
+  // Without a symbol read or an identified card there is nothing to score
+  auto unread = perfectRecord();
+  unread.identifiedRarity = "rare";
+  auto summary = bench::summarize({agrees, differs, unread}, 1000.0);
+
+  EXPECT_EQ(summary.rarity.correct, 1u);
+  EXPECT_EQ(summary.rarity.total, 2u);
+}
+
+TEST_F(EvaluationTest, LocallySortedCardsAreNotRejections) {
+  auto sorted = perfectRecord();
+  sorted.identified = false;
+  sorted.sortedLocally = true;
+  sorted.bin = 1;
+  sorted.binRule = "mythics";
+  auto summary = bench::summarize({sorted, perfectRecord()}, 1000.0);
+
+  EXPECT_EQ(summary.sortedLocally, 1u);
+  EXPECT_EQ(summary.rejected, 0u);
+  auto json = bench::toJson(summary, {sorted}, "");
+  EXPECT_NE(json.find("\"rule\": \"mythics\""), std::string::npos);
+}
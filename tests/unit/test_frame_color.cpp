@@ -0,0 +1,72 @@
+#include <frame_color.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+#include <utility>
+#include <vector>
+
+// Test fixture for the frame color classifier
+class FrameColorTest : public ::testing::Test {
+protected:
+  // Black border, frame in the given color, art, text box and title text
+  static cv::Mat createCard(const cv::Scalar &frame) {
+    cv::Mat card(680, 480, CV_8UC3, cv::Scalar(20, 20, 20));
+    cv::rectangle(card, cv::Rect(20, 20, 440, 640), frame, cv::FILLED);
+    cv::rectangle(card, cv::Rect(43, 75, 394, 299), cv::Scalar(60, 140, 90),
+                  cv::FILLED); // Art
+    cv::rectangle(card, cv::Rect(43, 422, 394, 177),
+                  cv::Scalar(210, 215, 220), cv::FILLED); // Text box
+    cv::putText(card, "Card Name", cv::Point(48, 58),
+                cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(10, 10, 10), 2);
+    return card;
+  }
+};
+
+// ============== Classification Tests ==============
+
+TEST_F(FrameColorTest, FramesAreClassifiedByColor) {
+  detect::FrameColorClassifier classifier;
+  const std::vector<std::pair<cv::Scalar, detect::FrameColor>> frames{
+      {cv::Scalar(200, 225, 235), detect::FrameColor::white},
+      {cv::Scalar(190, 110, 40), detect::FrameColor::blue},
+      {cv::Scalar(45, 45, 50), detect::FrameColor::black},
+      {cv::Scalar(40, 50, 190), detect::FrameColor::red},
+      {cv::Scalar(70, 120, 50), detect::FrameColor::green},
+      {cv::Scalar(80, 170, 205), detect::FrameColor::multicolor},
+      {cv::Scalar(170, 155, 140), detect::FrameColor::artifact},
+      {cv::Scalar(80, 110, 140), detect::FrameColor::land}};
+
+  for (const auto &[frame, expected] : frames) {
+    auto decision = classifier.classify(createCard(frame));
+    EXPECT_EQ(decision.color, expected)
+        << "expected " << detect::frameColorName(expected) << ", got "
+        << detect::frameColorName(decision.color);
+    EXPECT_GT(decision.confidence, 0.0);
+  }
+}
+
+TEST_F(FrameColorTest, ConfidenceIsHigherForAClearColor) {
+  detect::FrameColorClassifier classifier;
+  // Pure red frame versus an orange between red and gold
+  auto clear = classifier.classify(createCard(cv::Scalar(40, 50, 190)));
+  auto between = classifier.classify(createCard(cv::Scalar(40, 120, 210)));
+
+  EXPECT_GT(clear.confidence, between.confidence);
+}
+
+// ============== Learning Tests ==============
+
+TEST_F(FrameColorTest, LearningMovesTheSignature) {
+  detect::FrameColorClassifier classifier;
+  cv::Mat teal = createCard(cv::Scalar(160, 160, 40));
+  auto before = classifier.classify(teal);
+
+  for (int i = 0; i < 20; ++i) {
+    classifier.learn(teal, detect::FrameColor::blue);
+  }
+  auto after = classifier.classify(teal);
+
+  EXPECT_EQ(classifier.learnedCount(), 20U);
+  EXPECT_EQ(after.color, detect::FrameColor::blue);
+  EXPECT_GT(after.similarity, before.similarity);
+}
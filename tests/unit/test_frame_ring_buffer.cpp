@@ -0,0 +1,143 @@
+#include <camera_stream.hpp>
+#include <frame_ring_buffer.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// Test fixture for the capture ring buffer
+class FrameRingBufferTest : public ::testing::Test {
+protected:
+  // Frame whose pixel value encodes its index
+  static cv::Mat frameWithValue(int value) {
+    return {4, 4, CV_8UC1, cv::Scalar(value)};
+  }
+};
+
+TEST_F(FrameRingBufferTest, PopReturnsNewestFrame) {
+  capture::FrameRingBuffer buffer(4);
+  buffer.push(frameWithValue(1));
+  buffer.push(frameWithValue(2));
+  buffer.push(frameWithValue(3));
+
+  capture::CapturedFrame frame;
+  ASSERT_TRUE(buffer.popLatest(frame, 0ms));
+  EXPECT_EQ(frame.sequence, 3u);
+  EXPECT_EQ(frame.image.at<uchar>(0, 0), 3);
+}
+
+TEST_F(FrameRingBufferTest, SkippedFramesCountAsDropped) {
+  capture::FrameRingBuffer buffer(2);
+  for (int i = 1; i <= 5; ++i) {
+    buffer.push(frameWithValue(i));
+  }
+
+  capture::CapturedFrame frame;
+  ASSERT_TRUE(buffer.popLatest(frame, 0ms));
+  EXPECT_EQ(frame.sequence, 5u);
+  EXPECT_EQ(buffer.pushedCount(), 5u);
+  EXPECT_EQ(buffer.consumedCount(), 1u);
+  EXPECT_EQ(buffer.droppedCount(), 4u);
+}
+
+TEST_F(FrameRingBufferTest, SameFrameIsNeverReturnedTwice) {
+  capture::FrameRingBuffer buffer(3);
+  buffer.push(frameWithValue(7));
+
+  capture::CapturedFrame frame;
+  ASSERT_TRUE(buffer.popLatest(frame, 0ms));
+  EXPECT_FALSE(buffer.popLatest(frame, 10ms));
+  EXPECT_EQ(buffer.droppedCount(), 0u);
+}
+
+TEST_F(FrameRingBufferTest, PoppedFrameIsNotOverwrittenByProducer) {
+  capture::FrameRingBuffer buffer(1);
+  buffer.push(frameWithValue(10));
+
+  capture::CapturedFrame frame;
+  ASSERT_TRUE(buffer.popLatest(frame, 0ms));
+  buffer.push(frameWithValue(20));
+
+  EXPECT_EQ(frame.image.at<uchar>(0, 0), 10);
+}
+
+TEST_F(FrameRingBufferTest, CloseWakesWaitingConsumer) {
+  capture::FrameRingBuffer buffer(2);
+  std::thread closer([&buffer] {
+    std::this_thread::sleep_for(20ms);
+    buffer.close();
+  });
+
+  capture::CapturedFrame frame;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(buffer.popLatest(frame, 5s));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+  closer.join();
+  EXPECT_TRUE(buffer.isClosed());
+}
+
+TEST_F(FrameRingBufferTest, ConcurrentProducerAccountsForEveryFrame) {
+  capture::FrameRingBuffer buffer(4);
+  constexpr int frame_count = 500;
+
+  std::thread producer([&buffer] {
+    for (int i = 0; i < frame_count; ++i) {
+      buffer.push(frameWithValue(i % 256));
+    }
+    buffer.close();
+  });
+
+  capture::CapturedFrame frame;
+  std::uint64_t last_sequence = 0;
+  while (buffer.popLatest(frame, 1s)) {
+    EXPECT_GT(frame.sequence, last_sequence);
+    last_sequence = frame.sequence;
+  }
+  producer.join();
+
+  EXPECT_EQ(last_sequence, static_cast<std::uint64_t>(frame_count));
+  EXPECT_EQ(buffer.consumedCount() + buffer.droppedCount(),
+            buffer.pushedCount());
+}
+
+// ============== Camera Stream Tests ==============
+
+TEST(CameraStreamTest, ReadsImageSequenceStandIn) {
+  auto dir = std::filesystem::temp_directory_path() / "camera_stream_tests";
+  std::filesystem::create_directories(dir);
+  for (int i = 0; i < 5; ++i) {
+    cv::Mat img(48, 64, CV_8UC3, cv::Scalar(i * 40, 0, 0));
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%03d.png", i);
+    cv::imwrite((dir / name).string(), img);
+  }
+
+  capture::CameraStream stream((dir / "frame_%03d.png").string(), 2);
+  ASSERT_TRUE(stream.start());
+
+  capture::CapturedFrame frame;
+  int received = 0;
+  while (!stream.isExhausted()) {
+    if (stream.nextFrame(frame, 500ms)) {
+      EXPECT_EQ(frame.image.cols, 64);
+      ++received;
+    }
+  }
+  stream.stop();
+
+  auto stats = stream.stats();
+  EXPECT_EQ(stats.captured, 5u);
+  EXPECT_GE(received, 1);
+  EXPECT_EQ(stats.processed + stats.dropped, stats.captured);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(CameraStreamTest, InvalidSourceFailsToStart) {
+  capture::CameraStream stream("/nonexistent/video.avi");
+  EXPECT_FALSE(stream.start());
+}
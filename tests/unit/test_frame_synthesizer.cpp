@@ -0,0 +1,140 @@
+#include <frame_synthesizer.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+#include <stdexcept>
+#include <tuple>
+
+// Test fixture for synthetic frame generation
+class FrameSynthesizerTest : public ::testing::Test {
+protected:
+  // Plain white card with a dark border, 480x680 like a warped card
+  static cv::Mat createCard() {
+    cv::Mat card(680, 480, CV_8UC3, cv::Scalar(240, 240, 240));
+    cv::rectangle(card, cv::Rect(0, 0, 480, 680), cv::Scalar(20, 20, 20), 20);
+    return card;
+  }
+
+  static bench::SynthesisParams smallFrameParams() {
+    bench::SynthesisParams params;
+    params.frameSize = cv::Size(640, 480);
+    return params;
+  }
+};
+
+TEST_F(FrameSynthesizerTest, FrameHasRequestedSizeAndType) {
+  bench::FrameSynthesizer synthesizer(smallFrameParams(), 42);
+  auto frame = synthesizer.generate(createCard());
+
+  EXPECT_EQ(frame.image.cols, 640);
+  EXPECT_EQ(frame.image.rows, 480);
+  EXPECT_EQ(frame.image.type(), CV_8UC3);
+}
+
+TEST_F(FrameSynthesizerTest, CornersLieInsideFrame) {
+  bench::FrameSynthesizer synthesizer(smallFrameParams(), 7);
+  cv::Mat card = createCard();
+
+  for (int i = 0; i < 50; ++i) {
+    auto frame = synthesizer.generate(card);
+    ASSERT_EQ(frame.corners.size(), 4u);
+    for (const auto &corner : frame.corners) {
+      EXPECT_GE(corner.x, 0.0F);
+      EXPECT_GE(corner.y, 0.0F);
+      EXPECT_LT(corner.x, 640.0F);
+      EXPECT_LT(corner.y, 480.0F);
+    }
+    // Quad keeps the card orientation, so it must stay convex
+    std::vector<cv::Point2f> quad = frame.corners;
+    EXPECT_TRUE(cv::isContourConvex(quad));
+  }
+}
+
+TEST_F(FrameSynthesizerTest, SameSeedGivesIdenticalFrames) {
+  bench::FrameSynthesizer first(smallFrameParams(), 1234);
+  bench::FrameSynthesizer second(smallFrameParams(), 1234);
+  cv::Mat card = createCard();
+
+  auto a = first.generate(card);
+  auto b = second.generate(card);
+
+  EXPECT_EQ(cv::norm(a.image, b.image, cv::NORM_INF), 0.0);
+  for (size_t i = 0; i < a.corners.size(); ++i) {
+    EXPECT_FLOAT_EQ(a.corners[i].x, b.corners[i].x);
+    EXPECT_FLOAT_EQ(a.corners[i].y, b.corners[i].y);
+  }
+}
+
+TEST_F(FrameSynthesizerTest, CardIsVisibleAtLabeledPosition) {
+  bench::SynthesisParams params = smallFrameParams();
+  params.maxNoiseStddev = 0.0;
+  params.maxBlurSigma = 0.0;
+  bench::FrameSynthesizer synthesizer(params, 99);
+  auto frame = synthesizer.generate(createCard());
+
+  // Centre of the quad falls on the bright card face
+  cv::Point2f center(0.0F, 0.0F);
+  for (const auto &corner : frame.corners) {
+    center += corner * 0.25F;
+  }
+  cv::Vec3b pixel = frame.image.at<cv::Vec3b>(cv::Point(center));
+  EXPECT_GT(pixel[0], 100);
+}
+
+TEST_F(FrameSynthesizerTest, UsesProvidedBackground) {
+  bench::SynthesisParams params = smallFrameParams();
+  params.maxNoiseStddev = 0.0;
+  params.maxBlurSigma = 0.0;
+  params.maxGradient = 0.0;
+  params.minGain = 1.0;
+  params.maxGain = 1.0;
+  params.maxBias = 0.0;
+  params.maxCardHeight = 0.5;
+  params.minCardHeight = 0.5;
+  bench::FrameSynthesizer synthesizer(params, 5);
+
+  cv::Mat background(100, 100, CV_8UC3, cv::Scalar(0, 0, 200));
+  auto frame = synthesizer.generate(createCard(), background);
+
+  // A half-height card can never cover the frame's top-left pixel and
+  // its opposite corner at the same time
+  cv::Vec3b top_left = frame.image.at<cv::Vec3b>(0, 0);
+  cv::Vec3b bottom_right = frame.image.at<cv::Vec3b>(479, 639);
+  bool background_visible = top_left[2] == 200 || bottom_right[2] == 200;
+  EXPECT_TRUE(background_visible);
+}
+
+TEST_F(FrameSynthesizerTest, LabeledCornersMatchTheRenderedCard) {
+  bench::SynthesisParams params = smallFrameParams();
+  params.maxNoiseStddev = 0.0;
+  params.maxBlurSigma = 0.0;
+  params.maxGradient = 0.0;
+  params.minGain = 1.0;
+  params.maxGain = 1.0;
+  params.maxBias = 0.0;
+  // Too large to fit unshrunk, so every frame goes through the fit loop
+  params.minCardHeight = 1.0;
+  params.maxCardHeight = 1.0;
+  bench::FrameSynthesizer synthesizer(params, 11);
+  cv::Mat background(100, 100, CV_8UC3, cv::Scalar(0, 0, 200));
+
+  for (int i = 0; i < 10; ++i) {
+    auto frame = synthesizer.generate(createCard(), background);
+    cv::Mat card_pixels;
+    cv::inRange(frame.image, cv::Scalar(0, 0, 200), cv::Scalar(0, 0, 200),
+                card_pixels);
+    double rendered = static_cast<double>(card_pixels.total()) -
+                      cv::countNonZero(card_pixels);
+
+    EXPECT_NEAR(rendered / cv::contourArea(frame.corners), 1.0, 0.02);
+  }
+}
+
+TEST_F(FrameSynthesizerTest, UnfittableCardThrows) {
+  bench::SynthesisParams params = smallFrameParams();
+  params.maxPerspective = 10.0; // Jitter alone is many times the card
+  bench::FrameSynthesizer synthesizer(params, 3);
+
+  EXPECT_THROW(std::ignore = synthesizer.generate(createCard()),
+               std::runtime_error);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <image_quality.hpp>
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+// Test fixture for the pre-OCR quality gate
+class ImageQualityTest : public ::testing::Test {
+protected:
+  // Card-sized image with a line of text in the name region
+  static cv::Mat createCard() {
+    cv::Mat card(680, 480, CV_8UC3, cv::Scalar(200, 210, 205));
+    cv::putText(card, "Queen Marchesa", cv::Point(25, 55),
+                cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(20, 20, 20), 2);
+    return card;
+  }
+
+  static std::vector<cv::Rect> nameRegion() {
+    return {cv::Rect(19, 22, 360, 44)};
+  }
+};
+
+// ============== Focus Tests ==============
+
+TEST_F(ImageQualityTest, BlurLowersFocusScore) {
+  cv::Mat sharp = createCard();
+  cv::Mat blurred;
+  cv::GaussianBlur(sharp, blurred, cv::Size(0, 0), 4.0);
+
+  EXPECT_GT(detect::assessQuality(sharp, nameRegion()).focus,
+            4.0 * detect::assessQuality(blurred, nameRegion()).focus);
+}
+
+TEST_F(ImageQualityTest, SharpCardIsAccepted) {
+  auto scores = detect::assessQuality(createCard(), nameRegion());
+
+  EXPECT_TRUE(scores.sharp);
+  EXPECT_TRUE(scores.exposed);
+  EXPECT_TRUE(scores.acceptable());
+}
+
+TEST_F(ImageQualityTest, BlurredCardIsRejected) {
+  cv::Mat blurred;
+  cv::GaussianBlur(createCard(), blurred, cv::Size(0, 0), 6.0);
+
+  auto scores = detect::assessQuality(blurred, nameRegion());
+
+  EXPECT_FALSE(scores.sharp);
+  EXPECT_FALSE(scores.acceptable());
+}
+
+TEST_F(ImageQualityTest, PooledFocusMatchesSingleRegion) {
+  cv::Mat card = createCard();
+  double single = detect::assessQuality(card, nameRegion()).focus;
+  // The same region in two halves, pooled
+  std::vector<cv::Rect> halves{cv::Rect(19, 22, 180, 44),
+                               cv::Rect(199, 22, 180, 44)};
+  double pooled = detect::assessQuality(card, halves).focus;
+
+  // Only the seam differs (neighbouring pixels vs. reflection)
+  EXPECT_NEAR(pooled, single, 0.05 * single);
+}
+
+// ============== Glare Tests ==============
+
+TEST_F(ImageQualityTest, GlareOverTextIsRejected) {
+  cv::Mat card = createCard();
+  cv::circle(card, cv::Point(150, 45), 60, cv::Scalar(255, 255, 255),
+             cv::FILLED);
+
+  auto scores = detect::assessQuality(card, nameRegion());
+
+  EXPECT_GT(scores.clippedRatio, 0.15);
+  EXPECT_FALSE(scores.exposed);
+  EXPECT_FALSE(scores.acceptable());
+}
+
+TEST_F(ImageQualityTest, GlareOutsideRegionsIsIgnored) {
+  cv::Mat card = createCard();
+  cv::circle(card, cv::Point(240, 400), 80, cv::Scalar(255, 255, 255),
+             cv::FILLED);
+
+  auto scores = detect::assessQuality(card, nameRegion());
+
+  EXPECT_DOUBLE_EQ(scores.clippedRatio, 0.0);
+  EXPECT_TRUE(scores.exposed);
+}
+
+TEST_F(ImageQualityTest, ThresholdsAreConfigurable) {
+  detect::QualityConfig strict;
+  strict.minFocus = 1e9;
+
+  auto scores = detect::assessQuality(createCard(), nameRegion(), strict);
+
+  EXPECT_FALSE(scores.sharp);
+}
+
+TEST_F(ImageQualityTest, RegionsOutsideTheCardAreClipped) {
+  std::vector<cv::Rect> regions = {cv::Rect(400, 600, 200, 200),
+                                   cv::Rect(1000, 1000, 10, 10)};
+
+  auto scores = detect::assessQuality(createCard(), regions);
+
+  EXPECT_DOUBLE_EQ(scores.focus, 0.0);
+  EXPECT_DOUBLE_EQ(scores.clippedRatio, 0.0);
+}
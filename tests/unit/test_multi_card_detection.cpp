@@ -0,0 +1,103 @@
+#include <card_detector.hpp>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+// Test fixture for binder-page (multi-card) detection
+class MultiCardDetectionTest : public ::testing::Test {
+protected:
+  static constexpr int cardWidth = 200;
+  static constexpr int cardHeight = 280;
+  static constexpr int gap = 40;
+
+  // 3x3 grid of bordered cards on a grey page
+  static cv::Mat createPage() {
+    cv::Mat page(3 * (cardHeight + gap) + gap, 3 * (cardWidth + gap) + gap,
+                 CV_8UC3, cv::Scalar(140, 140, 140));
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 3; ++col) {
+        cv::Rect card(gap + col * (cardWidth + gap),
+                      gap + row * (cardHeight + gap), cardWidth, cardHeight);
+        cv::rectangle(page, card, cv::Scalar(230, 230, 230), cv::FILLED);
+        cv::rectangle(page, card, cv::Scalar(15, 15, 15), 10);
+      }
+    }
+    return page;
+  }
+
+  static std::vector<cv::Point2f> quad(float x, float y) {
+    return {cv::Point2f(x, y), cv::Point2f(x + 10, y),
+            cv::Point2f(x + 10, y + 14), cv::Point2f(x, y + 14)};
+  }
+};
+
+// ============== Reading Order Tests ==============
+
+TEST_F(MultiCardDetectionTest, ReadingOrderIsRowsThenColumns) {
+  // Slightly uneven rows, as in a photo taken at an angle
+  std::vector<std::vector<cv::Point2f>> cards = {
+      quad(40, 31), quad(0, 0), quad(20, 2), quad(1, 30), quad(21, 29)};
+
+  detect::detail::sortReadingOrder(cards);
+
+  ASSERT_EQ(cards.size(), 5u);
+  EXPECT_EQ(cards[0][0], cv::Point2f(0, 0));
+  EXPECT_EQ(cards[1][0], cv::Point2f(20, 2));
+  EXPECT_EQ(cards[2][0], cv::Point2f(1, 30));
+  EXPECT_EQ(cards[3][0], cv::Point2f(21, 29));
+  EXPECT_EQ(cards[4][0], cv::Point2f(40, 31));
+}
+
+TEST_F(MultiCardDetectionTest, ReadingOrderHandlesEmptyInput) {
+  std::vector<std::vector<cv::Point2f>> cards;
+  detect::detail::sortReadingOrder(cards);
+  EXPECT_TRUE(cards.empty());
+}
+
+// ============== Page Detection Tests ==============
+
+TEST_F(MultiCardDetectionTest, FindsEveryCardOnPage) {
+  auto cards = detect::processAllCards(createPage());
+
+  ASSERT_EQ(cards.size(), 9u);
+  for (std::size_t i = 0; i < cards.size(); ++i) {
+    EXPECT_EQ(cards[i].image.cols, detect::detail::normalizedWidth);
+    EXPECT_EQ(cards[i].image.rows, detect::detail::normalizedHeight);
+
+    // Reading order: top-left corner of card i is in row i / 3, col i % 3
+    auto expected_x = static_cast<float>(gap + (i % 3) * (cardWidth + gap));
+    auto expected_y = static_cast<float>(gap + (i / 3) * (cardHeight + gap));
+    EXPECT_NEAR(cards[i].corners[0].x, expected_x, 8.0F) << i;
+    EXPECT_NEAR(cards[i].corners[0].y, expected_y, 8.0F) << i;
+  }
+}
+
+TEST_F(MultiCardDetectionTest, PageOutlineDoesNotHideTheCards) {
+  // Binder page photographed with its edge: a card-shaped outline around
+  // the pockets
+  cv::Mat page = createPage();
+  cv::rectangle(page, cv::Rect(10, 10, page.cols - 20, page.rows - 20),
+                cv::Scalar(15, 15, 15), 4);
+
+  auto cards = detect::processAllCards(page);
+
+  ASSERT_EQ(cards.size(), 9u);
+  for (std::size_t i = 0; i < cards.size(); ++i) {
+    auto expected_x = static_cast<float>(gap + (i % 3) * (cardWidth + gap));
+    auto expected_y = static_cast<float>(gap + (i / 3) * (cardHeight + gap));
+    EXPECT_NEAR(cards[i].corners[0].x, expected_x, 8.0F) << i;
+    EXPECT_NEAR(cards[i].corners[0].y, expected_y, 8.0F) << i;
+  }
+}
+
+TEST_F(MultiCardDetectionTest, EmptyPageHasNoCards) {
+  cv::Mat page(600, 800, CV_8UC3, cv::Scalar(140, 140, 140));
+  EXPECT_TRUE(detect::processAllCards(page).empty());
+}
+
+TEST_F(MultiCardDetectionTest, EmptyFrameThrows) {
+  EXPECT_THROW(std::ignore = detect::processAllCards(cv::Mat()),
+               std::runtime_error);
+}
@@ -201,3 +201,36 @@ TEST_F(OcrPreprocessingTest, PreservesTextContrast) {
   EXPECT_GT(blackPixels, 0) << "Should have some black pixels (text)";
   EXPECT_GT(whitePixels, 0) << "Should have some white pixels (background)";
 }
+
+// ============== Preprocessing Path Tests ==============
+
+TEST_F(OcrPreprocessingTest, NativeAndLegacyPathsAgree) {
+  cv::Mat textImage = createTextImage();
+  auto settings = detect::defaultCardNameSettings();
+  settings.preprocessing = detect::OcrPreprocessing::native;
+  cv::Mat native = detect::preprocessForOcr(textImage, settings);
+  settings.preprocessing = detect::OcrPreprocessing::legacy;
+  cv::Mat legacy = detect::preprocessForOcr(textImage, settings);
+
+  ASSERT_EQ(native.size(), legacy.size());
+  double differing =
+      static_cast<double>(cv::countNonZero(native != legacy)) / native.total();
+  EXPECT_LT(differing, 0.05) << "Only stroke edges may differ";
+}
+
+TEST_F(OcrPreprocessingTest, NativePathIsStrictlyBinary) {
+  cv::Mat processed = detect::preprocessForOcr(createTextImage());
+  int binary = cv::countNonZero(processed == 0) +
+               cv::countNonZero(processed == 255);
+  EXPECT_EQ(binary, processed.rows * processed.cols);
+}
+
+TEST_F(OcrPreprocessingTest, NativePathInvertsLightText) {
+  cv::Mat lightText;
+  cv::bitwise_not(createTextImage(), lightText);
+  cv::Mat processed = detect::preprocessForOcr(lightText);
+
+  // Background becomes white, the text dark
+  EXPECT_EQ(processed.at<uchar>(0, 0), 255);
+  EXPECT_GT(cv::countNonZero(processed), processed.rows * processed.cols / 2);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <ocr_profile.hpp>
+#include <path_helper.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+// Test fixture for loading per-field OCR profiles
+class OcrProfileTest : public ::testing::Test {
+protected:
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "ocr_profile_test.json";
+
+  void TearDown() override { std::filesystem::remove(path); }
+
+  detect::OcrProfile loadJson(const std::string &json) {
+    {
+      std::ofstream file(path);
+      file << json;
+    }
+    return detect::OcrProfile::load(path);
+  }
+};
+
+// ============== Default Tests ==============
+
+TEST_F(OcrProfileTest, DefaultProfileReadsEverythingWithBest) {
+  detect::OcrProfile profile;
+  EXPECT_EQ(profile.name, "best");
+  EXPECT_EQ(profile.cardName.model, "best");
+  EXPECT_EQ(profile.collectorNumber.whitelist, "0123456789");
+  EXPECT_DOUBLE_EQ(profile.collectorNumber.scale, 4.0);
+  EXPECT_EQ(profile.setCode.pageSegMode, 8);
+  EXPECT_EQ(profile.setCode.interpolation, detect::OcrInterpolation::lanczos);
+}
+
+// ============== Loading Tests ==============
+
+TEST_F(OcrProfileTest, LeftOutSettingsKeepTheirDefault) {
+  auto profile = loadJson(R"({"name": "digits", "fields": {
+      "collector_number": {"model": "fast", "oem": 1, "filter": "none",
+                           "preprocessing": "legacy"}}})");
+  EXPECT_EQ(profile.name, "digits");
+  EXPECT_EQ(profile.collectorNumber.model, "fast");
+  EXPECT_EQ(profile.collectorNumber.engineMode, 1);
+  EXPECT_EQ(profile.collectorNumber.filter, detect::OcrFilter::none);
+  EXPECT_EQ(profile.collectorNumber.preprocessing,
+            detect::OcrPreprocessing::legacy);
+  EXPECT_EQ(profile.setCode.preprocessing, detect::OcrPreprocessing::native);
+  EXPECT_EQ(profile.collectorNumber.whitelist, "0123456789");
+  EXPECT_EQ(profile.setCode.model, "best");
+}
+
+TEST_F(OcrProfileTest, NameDefaultsToFileStem) {
+  EXPECT_EQ(loadJson("{}").name, "ocr_profile_test");
+}
+
+TEST_F(OcrProfileTest, UnknownSettingThrows) {
+  EXPECT_THROW(
+      std::ignore = loadJson(R"({"fields": {"name": {"scael": 2.0}}})"),
+      std::runtime_error);
+  EXPECT_THROW(
+      std::ignore = loadJson(R"({"fields": {"name": {"filter": "gauss"}}})"),
+      std::runtime_error);
+  EXPECT_THROW(
+      std::ignore = loadJson(R"({"fields": {"rarity": {"scale": 2.0}}})"),
+      std::runtime_error);
+}
+
+TEST_F(OcrProfileTest, InvalidJsonThrows) {
+  EXPECT_THROW(std::ignore = loadJson("{\"fields\": "), std::runtime_error);
+  EXPECT_THROW(
+      std::ignore = loadJson(R"({"fields": {"name": {"scale": "big"}}})"),
+      std::runtime_error);
+}
+
+TEST_F(OcrProfileTest, MissingFileThrows) {
+  EXPECT_THROW(std::ignore = detect::OcrProfile::load(
+                   "/nonexistent/ocr_profile.json"),
+               std::runtime_error);
+}
+
+TEST_F(OcrProfileTest, ShippedProfilesLoad) {
+  auto best = detect::OcrProfile::load(detect::ocrProfilePath("best"));
+  detect::OcrProfile defaults;
+  EXPECT_EQ(best.cardName.whitelist, defaults.cardName.whitelist);
+  EXPECT_DOUBLE_EQ(best.setCode.scale, defaults.setCode.scale);
+
+  auto fast = detect::OcrProfile::load(detect::ocrProfilePath("fast"));
+  EXPECT_EQ(fast.name, "fast");
+  EXPECT_EQ(fast.cardName.model, "best");
+  EXPECT_EQ(fast.collectorNumber.model, "fast");
+  EXPECT_EQ(fast.setCode.model, "fast");
+}
+
+// ============== Combined Key Pass Tests ==============
+
+TEST_F(OcrProfileTest, ShippedProfilesAllowTheCombinedKeyPass) {
+  EXPECT_EQ(detect::OcrProfile{}.combinedKeyConflict(), "");
+  EXPECT_EQ(detect::OcrProfile::load(detect::ocrProfilePath("best"))
+                .combinedKeyConflict(),
+            "");
+  EXPECT_EQ(detect::OcrProfile::load(detect::ocrProfilePath("fast"))
+                .combinedKeyConflict(),
+            "");
+}
+
+TEST_F(OcrProfileTest, DifferentKeyEnginesConflict) {
+  auto profile = loadJson(R"({"fields": {
+    "collector_number": {"model": "fast", "oem": 1}
+  }})");
+  EXPECT_EQ(profile.combinedKeyConflict(), "model");
+
+  profile.collectorNumber.model = profile.setCode.model;
+  EXPECT_EQ(profile.combinedKeyConflict(), "oem");
+
+  profile.collectorNumber.engineMode = profile.setCode.engineMode;
+  profile.collectorNumber.filter = detect::OcrFilter::median;
+  EXPECT_EQ(profile.combinedKeyConflict(), "filter");
+}
+
+TEST_F(OcrProfileTest, KeyScaleDoesNotConflict) {
+  auto profile = loadJson(R"({"fields": {
+    "collector_number": {"scale": 2.0, "interpolation": "linear"}
+  }})");
+  EXPECT_EQ(profile.combinedKeyConflict(), "");
+}
+
+TEST_F(OcrProfileTest, PathsAreNotShippedNames) {
+  EXPECT_EQ(detect::ocrProfilePath("fast"),
+            misc::getDataPath() / "ocr_profiles" / "fast.json");
+  EXPECT_EQ(detect::ocrProfilePath("my.json"),
+            std::filesystem::path("my.json"));
+  EXPECT_EQ(detect::ocrProfilePath("/tmp/fast"),
+            std::filesystem::path("/tmp/fast"));
+}
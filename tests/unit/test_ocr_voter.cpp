@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <ocr_voter.hpp>
+
+// Test fixture for multi-frame OCR voting
+class OcrVoterTest : public ::testing::Test {
+protected:
+  workflow::OcrVoter voter;
+
+  void addFrame(const std::string &setName, int setConfidence,
+                const std::string &number, int numberConfidence) {
+    voter.add("Queen Marchesa", 80, setName, setConfidence, number,
+              numberConfidence);
+  }
+};
+
+// ============== Early Termination Tests ==============
+
+TEST_F(OcrVoterTest, ConfidentFrameSettlesImmediately) {
+  addFrame("CN2", 92, "78", 95);
+
+  EXPECT_TRUE(voter.isSettled());
+  EXPECT_TRUE(voter.isDone());
+  auto consensus = voter.consensus();
+  EXPECT_EQ(consensus.setName.text, "CN2");
+  EXPECT_EQ(consensus.collectorNumber.text, "78");
+  EXPECT_EQ(consensus.frames, 1);
+}
+
+TEST_F(OcrVoterTest, UncertainFramesAccumulate) {
+  addFrame("CN2", 60, "78", 55);
+  EXPECT_FALSE(voter.isSettled());
+
+  addFrame("CN2", 58, "78", 62);
+  EXPECT_TRUE(voter.isSettled());
+  EXPECT_EQ(voter.consensus().collectorNumber.score, 117);
+}
+
+TEST_F(OcrVoterTest, EmptyReadingsDoNotVote) {
+  addFrame("", 0, "78", 95);
+
+  EXPECT_FALSE(voter.isSettled());
+  EXPECT_TRUE(voter.consensus().setName.text.empty());
+}
+
+// ============== Conflict Tests ==============
+
+TEST_F(OcrVoterTest, ConflictingReadingsNeedAgreement) {
+  addFrame("CN2", 90, "78", 90);
+  // A second confident but different set code splits the vote
+  addFrame("CNZ", 88, "78", 90);
+
+  EXPECT_FALSE(voter.isSettled());
+  auto set_name = voter.consensus().setName;
+  EXPECT_EQ(set_name.text, "CN2");
+  EXPECT_LT(set_name.agreement, 0.6);
+
+  addFrame("CN2", 85, "78", 90);
+  EXPECT_TRUE(voter.isSettled());
+}
+
+TEST_F(OcrVoterTest, FrameLimitEndsVoting) {
+  workflow::VoteConfig config;
+  config.maxFrames = 2;
+  workflow::OcrVoter limited(config);
+
+  limited.add("Queen", 40, "CN2", 30, "78", 20);
+  EXPECT_FALSE(limited.isDone());
+  limited.add("Queen", 40, "CN2", 30, "78", 20);
+
+  EXPECT_FALSE(limited.isSettled());
+  EXPECT_TRUE(limited.isDone());
+  EXPECT_EQ(limited.consensus().setName.text, "CN2");
+}
+
+TEST_F(OcrVoterTest, ResetForgetsAllReadings) {
+  addFrame("CN2", 92, "78", 95);
+  voter.reset();
+
+  EXPECT_EQ(voter.frames(), 0);
+  EXPECT_FALSE(voter.isSettled());
+  EXPECT_TRUE(voter.consensus().cardName.text.empty());
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <presence_gate.hpp>
+
+// Test fixture for the presence/motion gate
+class PresenceGateTest : public ::testing::Test {
+protected:
+  static constexpr int frameWidth = 640;
+  static constexpr int frameHeight = 480;
+
+  // Empty slot: dark textured background
+  static cv::Mat emptyFrame() {
+    cv::Mat frame(frameHeight, frameWidth, CV_8UC3, cv::Scalar(40, 60, 50));
+    for (int x = 0; x < frameWidth; x += 40) {
+      cv::line(frame, cv::Point(x, 0), cv::Point(x, frameHeight - 1),
+               cv::Scalar(55, 75, 65), 2);
+    }
+    return frame;
+  }
+
+  // Bright card at a horizontal offset
+  static cv::Mat cardFrame(int offsetX) {
+    cv::Mat frame = emptyFrame();
+    cv::rectangle(frame, cv::Rect(offsetX, 100, 200, 280),
+                  cv::Scalar(230, 230, 230), cv::FILLED);
+    return frame;
+  }
+
+  static void warmUp(detect::PresenceGate &gate) {
+    for (int i = 0; i < gate.config().warmupFrames; ++i) {
+      EXPECT_EQ(gate.update(emptyFrame()).state, detect::GateState::learning);
+    }
+  }
+};
+
+TEST_F(PresenceGateTest, EmptySlotIsNeverForwarded) {
+  detect::PresenceGate gate;
+  warmUp(gate);
+
+  for (int i = 0; i < 10; ++i) {
+    auto decision = gate.update(emptyFrame());
+    EXPECT_EQ(decision.state, detect::GateState::empty);
+    EXPECT_FALSE(decision.forward);
+  }
+}
+
+TEST_F(PresenceGateTest, StillCardIsForwardedAfterStableFrames) {
+  detect::PresenceGate gate;
+  warmUp(gate);
+
+  // Arrival frame is motion
+  auto decision = gate.update(cardFrame(200));
+  EXPECT_EQ(decision.state, detect::GateState::moving);
+  EXPECT_FALSE(decision.forward);
+
+  int forwarded_at = -1;
+  for (int i = 0; i < 10 && forwarded_at < 0; ++i) {
+    decision = gate.update(cardFrame(200));
+    if (decision.forward) {
+      forwarded_at = i;
+      EXPECT_TRUE(decision.arrival);
+      EXPECT_EQ(decision.state, detect::GateState::present);
+    }
+  }
+  EXPECT_EQ(forwarded_at, gate.config().stableFrames - 1);
+
+  // Later frames keep forwarding but are no longer arrivals
+  decision = gate.update(cardFrame(200));
+  EXPECT_TRUE(decision.forward);
+  EXPECT_FALSE(decision.arrival);
+}
+
+TEST_F(PresenceGateTest, MovingCardIsNotForwarded) {
+  detect::PresenceGate gate;
+  warmUp(gate);
+
+  for (int offset = 0; offset < 400; offset += 40) {
+    auto decision = gate.update(cardFrame(offset));
+    EXPECT_EQ(decision.state, detect::GateState::moving);
+    EXPECT_FALSE(decision.forward);
+  }
+}
+
+TEST_F(PresenceGateTest, RemovingCardReturnsToEmpty) {
+  detect::PresenceGate gate;
+  warmUp(gate);
+  for (int i = 0; i < 5; ++i) {
+    std::ignore = gate.update(cardFrame(200));
+  }
+
+  std::ignore = gate.update(emptyFrame()); // Card leaving is motion
+  auto decision = gate.update(emptyFrame());
+  EXPECT_EQ(decision.state, detect::GateState::empty);
+  EXPECT_LT(decision.presence, gate.config().presenceRatio);
+}
+
+TEST_F(PresenceGateTest, ResolutionChangeRestartsLearning) {
+  detect::PresenceGate gate;
+  warmUp(gate);
+
+  cv::Mat larger(960, 1280, CV_8UC3, cv::Scalar(40, 60, 50));
+  EXPECT_EQ(gate.update(larger).state, detect::GateState::learning);
+}
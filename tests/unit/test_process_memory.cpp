@@ -0,0 +1,16 @@
+#include <gtest/gtest.h>
+#include <process_memory.hpp>
+
+#include <filesystem>
+
+// ============== Process Memory Tests ==============
+
+TEST(ProcessMemoryTest, ProcessMemoryIsReported) {
+  if (!std::filesystem::exists("/proc/self/status")) {
+    GTEST_SKIP() << "No /proc on this system";
+  }
+  auto memory = misc::readProcessMemory();
+  EXPECT_GT(memory.residentKb, 0u);
+  EXPECT_GE(memory.peakKb, memory.residentKb);
+  EXPECT_LE(memory.anonymousKb + memory.fileKb, memory.residentKb + 4);
+}
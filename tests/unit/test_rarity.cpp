@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <rarity.hpp>
+
+#include <utility>
+#include <vector>
+
+// Test fixture for the set symbol rarity classifier
+class RarityTest : public ::testing::Test {
+protected:
+  // Set symbol region of a 480x680 card: light type line bar with a round
+  // symbol in the given color and a dark outline
+  static cv::Mat createSymbol(const cv::Scalar &fill) {
+    cv::Mat symbol(34, 52, CV_8UC3, cv::Scalar(200, 205, 210));
+    cv::circle(symbol, cv::Point(26, 17), 12, fill, cv::FILLED);
+    cv::circle(symbol, cv::Point(26, 17), 12, cv::Scalar(15, 15, 15), 1);
+    return symbol;
+  }
+};
+
+// ============== Classification Tests ==============
+
+TEST_F(RarityTest, SymbolColorsAreClassified) {
+  detect::RarityClassifier classifier;
+  const std::vector<std::pair<cv::Scalar, detect::Rarity>> symbols{
+      {cv::Scalar(25, 25, 25), detect::Rarity::common},
+      {cv::Scalar(185, 175, 165), detect::Rarity::uncommon},
+      {cv::Scalar(60, 170, 215), detect::Rarity::rare},
+      {cv::Scalar(30, 80, 230), detect::Rarity::mythic}};
+
+  for (const auto &[fill, expected] : symbols) {
+    auto decision = classifier.classify(createSymbol(fill));
+    EXPECT_EQ(decision.rarity, expected)
+        << "expected " << detect::rarityName(expected) << ", got "
+        << detect::rarityName(decision.rarity);
+    EXPECT_GT(decision.confidence, 0.0);
+    EXPECT_GT(decision.symbolRatio, 0.2);
+  }
+}
+
+TEST_F(RarityTest, EmptyRegionHasNoConfidence) {
+  detect::RarityClassifier classifier;
+  cv::Mat bar(34, 52, CV_8UC3, cv::Scalar(200, 205, 210));
+
+  auto decision = classifier.classify(bar);
+
+  EXPECT_DOUBLE_EQ(decision.confidence, 0.0);
+  EXPECT_DOUBLE_EQ(decision.symbolRatio, 0.0);
+}
+
+TEST_F(RarityTest, TypeLineTextIsNotTheSymbol) {
+  detect::RarityClassifier classifier;
+  cv::Mat symbol = createSymbol(cv::Scalar(60, 170, 215));
+  // End of a long type line running into the region
+  cv::putText(symbol, "n", cv::Point(0, 22), cv::FONT_HERSHEY_SIMPLEX, 0.5,
+              cv::Scalar(10, 10, 10), 1);
+
+  EXPECT_EQ(classifier.classify(symbol).rarity, detect::Rarity::rare);
+}
+
+// ============== Name Tests ==============
+
+TEST_F(RarityTest, ScryfallNamesRoundTrip) {
+  for (auto rarity : {detect::Rarity::common, detect::Rarity::uncommon,
+                      detect::Rarity::rare, detect::Rarity::mythic}) {
+    EXPECT_EQ(detect::parseRarity(detect::rarityName(rarity)), rarity);
+  }
+  EXPECT_FALSE(detect::parseRarity("special").has_value());
+}
+
+// ============== Learning Tests ==============
+
+TEST_F(RarityTest, LearningMovesThePrototype) {
+  detect::RarityClassifier classifier;
+  // A pale gold, closer to silver than to the printed gold
+  cv::Mat pale = createSymbol(cv::Scalar(150, 175, 190));
+
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(classifier.learn(pale, detect::Rarity::rare));
+  }
+
+  EXPECT_EQ(classifier.learnedCount(), 20U);
+  EXPECT_EQ(classifier.classify(pale).rarity, detect::Rarity::rare);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <recognition_cache.hpp>
+#include <region_fingerprint.hpp>
+
+#include <string>
+#include <tuple>
+
+// Test fixture for region fingerprints and the recognition cache
+class RecognitionCacheTest : public ::testing::Test {
+protected:
+  // Dark text on a light bar, like a name region crop
+  static cv::Mat createRegion(const std::string &text) {
+    cv::Mat region(44, 360, CV_8UC3, cv::Scalar(190, 200, 210));
+    cv::putText(region, text, cv::Point(8, 32), cv::FONT_HERSHEY_SIMPLEX, 0.9,
+                cv::Scalar(10, 10, 10), 2);
+    return region;
+  }
+
+  static workflow::RegionFingerprints fingerprints(const std::string &name,
+                                                   const std::string &set,
+                                                   const std::string &number) {
+    return {detect::fingerprintRegion(createRegion(name)),
+            detect::fingerprintRegion(createRegion(set)),
+            detect::fingerprintRegion(createRegion(number))};
+  }
+
+  static workflow::CachedRecognition entry(const std::string &id,
+                                           const std::string &name) {
+    workflow::CachedRecognition cached;
+    cached.fingerprints = fingerprints(name, "DSC", "92");
+    cached.cardInfo.id = id;
+    cached.cardInfo.name = name;
+    cached.cardInfo.isValid = true;
+    cached.costMs = 250.0;
+    return cached;
+  }
+};
+
+// ============== Fingerprint Tests ==============
+
+TEST_F(RecognitionCacheTest, LightingChangeKeepsFingerprint) {
+  auto region = createRegion("Arcane Signet");
+  cv::Mat darker;
+  region.convertTo(darker, -1, 0.6, 10);
+
+  EXPECT_LE(detect::hammingDistance(detect::fingerprintRegion(region),
+                                    detect::fingerprintRegion(darker)),
+            8);
+}
+
+TEST_F(RecognitionCacheTest, DifferentTextIsFarApart) {
+  EXPECT_GT(detect::hammingDistance(
+                detect::fingerprintRegion(createRegion("Arcane Signet")),
+                detect::fingerprintRegion(createRegion("Sol Ring"))),
+            40);
+}
+
+// ============== Cache Tests ==============
+
+TEST_F(RecognitionCacheTest, RepeatedCardIsRecalled) {
+  workflow::RecognitionCache cache;
+  cache.insert(entry("signet", "Arcane Signet"));
+
+  auto hit = cache.find(fingerprints("Arcane Signet", "DSC", "92"));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->cardInfo.id, "signet");
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.lookups, 1u);
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_DOUBLE_EQ(stats.savedMs, 250.0);
+}
+
+TEST_F(RecognitionCacheTest, UnknownCardMisses) {
+  workflow::RecognitionCache cache;
+  cache.insert(entry("signet", "Arcane Signet"));
+
+  EXPECT_FALSE(cache.find(fingerprints("Sol Ring", "DSC", "92")).has_value());
+  EXPECT_DOUBLE_EQ(cache.stats().hitRate(), 0.0);
+}
+
+TEST_F(RecognitionCacheTest, LookalikePrintingsAreNotGuessed) {
+  workflow::RecognitionCache cache;
+  cache.insert(entry("signet-dsc", "Arcane Signet"));
+  cache.insert(entry("signet-reprint", "Arcane Signet"));
+
+  EXPECT_FALSE(
+      cache.find(fingerprints("Arcane Signet", "DSC", "92")).has_value());
+}
+
+TEST_F(RecognitionCacheTest, RepeatedInsertKeepsOneEntry) {
+  workflow::RecognitionCache cache;
+  cache.insert(entry("signet", "Arcane Signet"));
+  cache.insert(entry("signet", "Arcane Signet"));
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(RecognitionCacheTest, LeastRecentlyUsedIsEvicted) {
+  workflow::CacheConfig config;
+  config.capacity = 2;
+  workflow::RecognitionCache cache(config);
+  cache.insert(entry("signet", "Arcane Signet"));
+  cache.insert(entry("ring", "Sol Ring"));
+  std::ignore = cache.find(fingerprints("Arcane Signet", "DSC", "92"));
+  cache.insert(entry("orb", "Mind Stone"));
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_TRUE(
+      cache.find(fingerprints("Arcane Signet", "DSC", "92")).has_value());
+  EXPECT_FALSE(cache.find(fingerprints("Sol Ring", "DSC", "92")).has_value());
+}
@@ -143,6 +143,26 @@ TEST_F(RegionExtractionTest, SetNameRegionCorrectSize) {
   EXPECT_EQ(setRegion.height, expectedHeight);
 }
 
+// ============== Set Symbol Region Tests ==============
+
+TEST_F(RegionExtractionTest, SetSymbolRegionWithinBounds) {
+  cv::Mat card = createTestCard();
+  cv::Rect symbolRegion = detect::extractSetSymbolRegionModern(card);
+
+  verifyRectWithinBounds(symbolRegion, cardWidth, cardHeight);
+}
+
+TEST_F(RegionExtractionTest, SetSymbolRegionAtRightOfTypeLine) {
+  cv::Mat card = createTestCard();
+  cv::Rect symbolRegion = detect::extractSetSymbolRegionModern(card);
+  cv::Rect textRegion = detect::extractTextRegion(card);
+
+  // Right end of the type line, just above the text box
+  EXPECT_GT(symbolRegion.x, cardWidth * 3 / 4);
+  EXPECT_LE(symbolRegion.y + symbolRegion.height, textRegion.y);
+  EXPECT_GT(symbolRegion.y, cardHeight / 2);
+}
+
 // ============== Art Region Tests ==============
 // Note: extractArtRegionRegular uses edge detection to dynamically find art box
 // borders. With a simple test image, it may not find a valid contour and
@@ -272,3 +292,51 @@ TEST_F(RegionExtractionTest, NonStandardAspectRatio) {
   cv::Rect nameRegion2 = detect::extractNameRegion(tallCard);
   verifyRectWithinBounds(nameRegion2, tallCard.cols, tallCard.rows);
 }
+
+// ============== Text Line Fitting Tests ==============
+
+TEST_F(RegionExtractionTest, FitTextLineCropsToTheText) {
+  cv::Mat card(cardHeight, cardWidth, CV_8UC3, cv::Scalar(255, 255, 255));
+  cv::Rect region = detect::extractNameRegion(card);
+  cv::putText(card, "Queen", cv::Point(region.x + 6, region.y + 32),
+              cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(0, 0, 0), 2);
+  // A mana symbol at the far right of the name bar
+  cv::circle(card, cv::Point(region.x + region.width - 12, region.y + 22), 8,
+             cv::Scalar(0, 0, 0), cv::FILLED);
+
+  cv::Rect fitted = detect::fitTextLine(card, region);
+  verifyRectWithinBounds(fitted, card.cols, card.rows);
+  EXPECT_EQ(fitted & region, fitted) << "Fitted box must stay in the region";
+  EXPECT_LT(fitted.area(), region.area() / 2);
+  EXPECT_LT(fitted.br().x, region.x + region.width - 24)
+      << "Mana symbol should be left out";
+  EXPECT_LE(fitted.x, region.x + 8);
+  EXPECT_GE(fitted.height, 15);
+}
+
+TEST_F(RegionExtractionTest, FitTextLineIgnoresFrameLines) {
+  cv::Mat card(cardHeight, cardWidth, CV_8UC3, cv::Scalar(255, 255, 255));
+  cv::Rect region = detect::extractNameRegion(card);
+  cv::line(card, region.tl() + cv::Point(0, 1),
+           cv::Point(region.br().x, region.y + 1), cv::Scalar(0, 0, 0), 2);
+  cv::putText(card, "Queen", cv::Point(region.x + 6, region.y + 34),
+              cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(0, 0, 0), 2);
+
+  cv::Rect fitted = detect::fitTextLine(card, region);
+  EXPECT_GT(fitted.y, region.y + 4) << "Frame line should be cropped off";
+}
+
+TEST_F(RegionExtractionTest, FitTextLineHandlesLightText) {
+  cv::Mat card(cardHeight, cardWidth, CV_8UC3, cv::Scalar(20, 20, 20));
+  cv::Rect region = detect::extractNameRegion(card);
+  cv::putText(card, "Queen", cv::Point(region.x + 6, region.y + 32),
+              cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(240, 240, 240), 2);
+
+  EXPECT_LT(detect::fitTextLine(card, region).area(), region.area() / 2);
+}
+
+TEST_F(RegionExtractionTest, FitTextLineKeepsBlankRegion) {
+  cv::Mat card = createTestCard();
+  cv::Rect region = detect::extractCollectorNumberRegionModern(card);
+  EXPECT_EQ(detect::fitTextLine(card, region), region);
+}
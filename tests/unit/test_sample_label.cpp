@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <sample_label.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+// Test fixture for sample label parsing and CSV round trips
+class SampleLabelTest : public ::testing::Test {
+protected:
+  std::filesystem::path tempDir;
+
+  void SetUp() override {
+    tempDir = std::filesystem::temp_directory_path() / "sample_label_tests";
+    std::filesystem::create_directories(tempDir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(tempDir); }
+};
+
+// ============== File Name Parsing Tests ==============
+
+TEST_F(SampleLabelTest, ParsesSetNumberAndName) {
+  auto label = bench::parseLabelFromFilename("cn2-78-queen-marchesa.jpg");
+
+  ASSERT_TRUE(label.has_value());
+  EXPECT_EQ(label->setCode, "cn2");
+  EXPECT_EQ(label->collectorNumber, "78");
+  EXPECT_EQ(label->name, "queen marchesa");
+  EXPECT_TRUE(label->corners.empty());
+}
+
+TEST_F(SampleLabelTest, StripsLeadingZerosFromCollectorNumber) {
+  auto label = bench::parseLabelFromFilename("dsc-092-arcane-signet.png");
+
+  ASSERT_TRUE(label.has_value());
+  EXPECT_EQ(label->collectorNumber, "92");
+}
+
+TEST_F(SampleLabelTest, RejectsUnlabeledFileNames) {
+  EXPECT_FALSE(bench::parseLabelFromFilename("IMG_20250313_191648.jpg"));
+  EXPECT_FALSE(bench::parseLabelFromFilename("cn2-queen-marchesa.jpg"));
+  EXPECT_FALSE(bench::parseLabelFromFilename("cn2-78.jpg"));
+}
+
+// ============== CSV Tests ==============
+
+TEST_F(SampleLabelTest, CsvRoundTripPreservesFieldsAndCorners) {
+  bench::LabelMap labels;
+  bench::SampleLabel label;
+  label.setCode = "2xm";
+  label.collectorNumber = "64";
+  label.name = "Jace, the Mind Sculptor";
+  label.corners = {{10.5F, 20.0F}, {110.0F, 20.0F}, {110.0F, 160.0F},
+                   {10.5F, 160.0F}};
+  labels["frame_000000.jpg"] = label;
+
+  auto csv_path = tempDir / "labels.csv";
+  ASSERT_TRUE(bench::writeLabelCsv(csv_path, labels));
+
+  auto loaded = bench::readLabelCsv(csv_path);
+  ASSERT_EQ(loaded.size(), 1u);
+  const auto &result = loaded.at("frame_000000.jpg");
+  EXPECT_EQ(result.setCode, "2xm");
+  EXPECT_EQ(result.collectorNumber, "64");
+  EXPECT_EQ(result.name, "Jace, the Mind Sculptor");
+  ASSERT_EQ(result.corners.size(), 4u);
+  EXPECT_FLOAT_EQ(result.corners[0].x, 10.5F);
+  EXPECT_FLOAT_EQ(result.corners[2].y, 160.0F);
+}
+
+TEST_F(SampleLabelTest, SidecarTakesPrecedenceOverFileName) {
+  cv::Mat img(10, 10, CV_8UC3, cv::Scalar(0, 0, 0));
+  cv::imwrite((tempDir / "cn2-78-queen-marchesa.png").string(), img);
+  cv::imwrite((tempDir / "IMG_0001.png").string(), img);
+  cv::imwrite((tempDir / "IMG_0002.png").string(), img);
+
+  std::ofstream csv(tempDir / "labels.csv");
+  csv << "file,set,collector_number,name\n";
+  csv << "IMG_0001.png,dsc,92,Arcane Signet\n";
+  csv << "cn2-78-queen-marchesa.png,cn2,78,Queen Marchesa\n";
+  csv.close();
+
+  auto labels = bench::collectLabels(tempDir);
+
+  // IMG_0002 has neither a sidecar entry nor a parsable name
+  ASSERT_EQ(labels.size(), 2u);
+  EXPECT_EQ(labels.at("IMG_0001.png").name, "Arcane Signet");
+  EXPECT_EQ(labels.at("cn2-78-queen-marchesa.png").name, "Queen Marchesa");
+}
+
+TEST_F(SampleLabelTest, NormalizeFieldIgnoresCaseAndPunctuation) {
+  EXPECT_EQ(bench::normalizeField("Queen Marchesa"),
+            bench::normalizeField("queen-marchesa"));
+  EXPECT_EQ(bench::normalizeField("Jace, the Mind Sculptor"),
+            "jacethemindsculptor");
+}
@@ -55,6 +55,7 @@ TEST(CardInfoTest, DefaultConstructorInitializesEmpty) {
   EXPECT_TRUE(card.setName.empty());
   EXPECT_TRUE(card.collectorNumber.empty());
   EXPECT_TRUE(card.rarity.empty());
+  EXPECT_TRUE(card.colors.empty());
   EXPECT_TRUE(card.typeLine.empty());
   EXPECT_TRUE(card.manaCost.empty());
   EXPECT_TRUE(card.oracleText.empty());
@@ -297,6 +298,27 @@ TEST_F(ScryfallClientTest, SetCodeIsLowercasedForLookup) {
   }
 }
 
+TEST_F(ScryfallClientTest, ColorsAreReadInWubrgOrder) {
+  std::filesystem::create_directories(testCacheDir_);
+  std::ofstream(testCacheDir_ / "collector_dsc_92.json")
+      << R"({"id": "1", "name": "Azorius Card", "set": "dsc",
+             "collector_number": "92", "colors": ["U", "W"]})";
+  std::ofstream(testCacheDir_ / "collector_dsc_93.json")
+      << R"({"id": "2", "name": "Transforming Card", "set": "dsc",
+             "collector_number": "93",
+             "card_faces": [{"colors": ["G"]}, {"colors": ["B"]}]})";
+  api::ScryfallClient client(testCacheDir_);
+
+  auto azorius = client.getCardByCollectorNumber("dsc", "92");
+  auto transforming = client.getCardByCollectorNumber("dsc", "93");
+
+  ASSERT_TRUE(azorius.has_value());
+  EXPECT_EQ(azorius->colors, "WU");
+  // Double-faced cards take the colors of their front face
+  ASSERT_TRUE(transforming.has_value());
+  EXPECT_EQ(transforming->colors, "G");
+}
+
 // ============================================================================
 // Multiple client instances
 // ============================================================================
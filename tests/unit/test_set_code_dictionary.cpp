@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <path_helper.hpp>
+#include <set_code_dictionary.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+// Test fixture for matching set code reads to known codes
+class SetCodeDictionaryTest : public ::testing::Test {
+protected:
+  detect::SetCodeDictionary dictionary{
+      {"DSC", "OSC", "MKM", "BRO", "ONE", "NEO", "WOE", "LCI"}};
+};
+
+// ============== Matching Tests ==============
+
+TEST_F(SetCodeDictionaryTest, ValidReadIsKept) {
+  auto result = dictionary.correct({"DSC", 90});
+  EXPECT_EQ(result.text, "DSC");
+  EXPECT_EQ(result.confidence, 90);
+}
+
+TEST_F(SetCodeDictionaryTest, LookalikeLetterIsCorrected) {
+  EXPECT_EQ(dictionary.correct({"DSG", 85}).text, "DSC");
+  EXPECT_EQ(dictionary.correct({"MKN", 85}).text, "MKM");
+}
+
+TEST_F(SetCodeDictionaryTest, AlternativesDecide) {
+  // Tesseract preferred D for the last letter but also considered O
+  detect::OcrResult read{"BRD", 60, {{{'B', 60.0F}}, {{'R', 70.0F}},
+                                     {{'D', 50.0F}, {'O', 45.0F}}}};
+  EXPECT_EQ(dictionary.correct(read).text, "BRO");
+}
+
+TEST_F(SetCodeDictionaryTest, ImpossibleCodeIsUnknown) {
+  auto result = dictionary.correct({"XQZ", 90});
+  EXPECT_TRUE(result.text.empty());
+  EXPECT_EQ(result.confidence, 0);
+}
+
+TEST_F(SetCodeDictionaryTest, EmptyReadIsUnknown) {
+  EXPECT_TRUE(dictionary.correct({}).text.empty());
+}
+
+// ============== Loading Tests ==============
+
+TEST_F(SetCodeDictionaryTest, LoadSkipsCommentsAndUnreadableCodes) {
+  auto path = std::filesystem::temp_directory_path() / "set_codes_test.txt";
+  {
+    std::ofstream file(path);
+    file << "# known sets\ndsc\nMH3\nPLST\n  WOE  # Eldraine\n\n";
+  }
+  auto loaded = detect::SetCodeDictionary::load(path);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(loaded.size(), 2u);
+  EXPECT_TRUE(loaded.contains("DSC"));
+  EXPECT_TRUE(loaded.contains("WOE"));
+  EXPECT_FALSE(loaded.contains("MH3"));
+}
+
+TEST_F(SetCodeDictionaryTest, MissingFileThrows) {
+  EXPECT_THROW(std::ignore = detect::SetCodeDictionary::load(
+                   "/nonexistent/set_codes.txt"),
+               std::runtime_error);
+}
+
+TEST_F(SetCodeDictionaryTest, ShippedListLoads) {
+  auto shipped =
+      detect::SetCodeDictionary::load(misc::getDataPath() / "set_codes.txt");
+  EXPECT_GT(shipped.size(), 100u);
+  EXPECT_TRUE(shipped.contains("DSC"));
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+// ============== Thread Pool Tests ==============
+
+TEST(ThreadPoolTest, ReturnsTaskResults) {
+  misc::ThreadPool pool(4);
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.submit([i]() { return i * i; }));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+}
+
+TEST(ThreadPoolTest, DefaultSizeUsesAllHardwareThreads) {
+  misc::ThreadPool pool;
+  EXPECT_GE(pool.size(), 1u);
+}
+
+TEST(ThreadPoolTest, TasksRunConcurrently) {
+  misc::ThreadPool pool(2);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+
+  // The first task blocks until the second one has run
+  auto blocked = pool.submit([released]() {
+    return released.wait_for(std::chrono::seconds(5)) ==
+           std::future_status::ready;
+  });
+  auto releaser = pool.submit([&release]() { release.set_value(); });
+
+  releaser.get();
+  EXPECT_TRUE(blocked.get());
+}
+
+TEST(ThreadPoolTest, ExceptionsReachTheFuture) {
+  misc::ThreadPool pool(1);
+  auto failing = pool.submit([]() -> int {
+    throw std::runtime_error("task failed");
+  });
+  EXPECT_THROW(failing.get(), std::runtime_error);
+
+  // The worker survives the exception
+  EXPECT_EQ(pool.submit([]() { return 7; }).get(), 7);
+}
+
+TEST(ThreadPoolTest, DestructorRunsQueuedTasks) {
+  std::atomic<int> completed{0};
+  {
+    misc::ThreadPool pool(1);
+    for (int i = 0; i < 20; ++i) {
+      std::ignore = pool.submit([&completed]() { ++completed; });
+    }
+  }
+  EXPECT_EQ(completed.load(), 20);
+}
+
+TEST(ThreadPoolTest, NestedWaitsDoNotDeadlock) {
+  // A single worker waits on subtasks queued behind it; wait() runs them
+  misc::ThreadPool pool(1);
+  auto outer = pool.submit([&pool]() {
+    std::vector<std::future<int>> inner;
+    for (int i = 1; i <= 10; ++i) {
+      inner.push_back(pool.submit([i]() { return i; }));
+    }
+    int sum = 0;
+    for (auto &future : inner) {
+      sum += pool.wait(future);
+    }
+    return sum;
+  });
+  EXPECT_EQ(pool.wait(outer), 55);
+}
+
+TEST(ThreadPoolTest, WorkersReportTheirIndex) {
+  misc::ThreadPool pool(2);
+  EXPECT_EQ(pool.workerIndex(), -1);
+  auto index = pool.submit([&pool]() { return pool.workerIndex(); });
+  int worker = index.get();
+  EXPECT_GE(worker, 0);
+  EXPECT_LT(worker, 2);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversEveryIndexOnce) {
+  misc::ThreadPool pool(3);
+  std::vector<std::atomic<int>> visits(1000);
+  pool.parallelFor(visits.size(), [&visits](std::size_t begin,
+                                            std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      ++visits[i];
+    }
+  });
+
+  int total = 0;
+  for (const auto &count : visits) {
+    EXPECT_EQ(count.load(), 1);
+    total += count.load();
+  }
+  EXPECT_EQ(total, 1000);
+}
+
+TEST(ThreadPoolTest, NestedParallelForCompletes) {
+  misc::ThreadPool pool(2);
+  std::atomic<int> cells{0};
+  pool.parallelFor(8, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t row = begin; row < end; ++row) {
+      pool.parallelFor(8, [&cells](std::size_t first, std::size_t last) {
+        cells += static_cast<int>(last - first);
+      });
+    }
+  });
+  EXPECT_EQ(cells.load(), 64);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows) {
+  misc::ThreadPool pool(2);
+  EXPECT_THROW(pool.parallelFor(100,
+                                [](std::size_t begin, std::size_t end) {
+                                  if (begin <= 50 && 50 < end) {
+                                    throw std::runtime_error("chunk failed");
+                                  }
+                                }),
+               std::runtime_error);
+}